@@ -0,0 +1,218 @@
+// ============================================================================
+//! \file   EECValidation.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Validates the grid (FFT) EEC vs. dR against the
+//! exact pair loop, on synthetic events of a few
+//! jets over a flat background, for several grid
+//! sizes and multiplicities.
+//!
+//! Usage: epnec-bench-eec [multiplicity ...]
+//!   - for each grid, reports the cell diagonal
+//!     (bound on the dR error of a pair), the
+//!     relative difference of the summed weight,
+//!     the largest bin difference relative to the
+//!     peak bin, the shift of the mean dR, and the
+//!     time per event of each kernel
+//!   - use it to pick gridMin: the multiplicity
+//!     where the grid starts to win
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+// package components
+#include "Calculator.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Make a synthetic event of nPar massless particles
+// ============================================================================
+//! Half of the particles come from 3 jets (gaussian
+//! in y and phi around random axes), the rest are
+//! spread flat in y in [-6, 2] and in phi.
+ParticleColumns makeEvent(const std::size_t nPar, std::mt19937& rng) {
+
+  std::uniform_real_distribution<float>  flatY(-6.f, 2.f);
+  std::uniform_real_distribution<float>  flatPhi(-3.14159265f, 3.14159265f);
+  std::exponential_distribution<float>   energy(1.f);
+  std::normal_distribution<float>        spread(0.f, 0.3f);
+
+  constexpr std::size_t nJets = 3;
+  float jetY[nJets];
+  float jetPhi[nJets];
+  for (std::size_t iJet = 0; iJet < nJets; ++iJet) {
+    jetY[iJet]   = flatY(rng) / 2.f;
+    jetPhi[iJet] = flatPhi(rng);
+  }
+
+  ParticleColumns event;
+  for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+    const bool  inJet = (iPar % 2 == 0);
+    const float y     = inJet ? jetY[iPar % nJets] + spread(rng) : flatY(rng);
+    const float phi   = inJet ? jetPhi[iPar % nJets] + spread(rng) : flatPhi(rng);
+    const float e     = energy(rng) + 0.1f;
+    const float th    = 2.f * std::atan(std::exp(y));
+    event.Add(e, e * std::sin(th) * std::cos(phi), e * std::sin(th) * std::sin(phi), e * std::cos(th), 211);
+  }
+  event.offsets.push_back(event.Size());
+  return event;
+
+}  // end 'makeEvent(std::size_t, std::mt19937&)'
+
+
+
+// ============================================================================
+//! Run events through a calculator, returns s/event
+// ============================================================================
+double runEvents(const Calculator& calc, const std::vector<ParticleColumns>& events, HistogramSet& hists) {
+
+  Calculator::EventScratch scratch = calc.MakeScratch();
+  hists = calc.GetTemplate();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& event : events) {
+    calc.ProcessEvent(Calculator::Level::Rec, 10.f, 0.01f, event.View(0), scratch, hists);
+  }
+  const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+  return took.count() / events.size();
+
+}  // end 'runEvents(Calculator&, std::vector<ParticleColumns>&, HistogramSet&)'
+
+
+
+// ============================================================================
+//! Find a 1D histogram by name
+// ============================================================================
+const Hist1D& findHist(const HistogramSet& hists, const std::string& name) {
+
+  for (const auto& hist : hists.h1) {
+    if (hist.GetName() == name) return hist;
+  }
+  std::fprintf(stderr, "PANIC: no histogram '%s'!\n", name.data());
+  std::exit(1);
+
+}  // end 'findHist(HistogramSet&, std::string&)'
+
+
+
+// ============================================================================
+//! Mean of a histogram over its in-range bins
+// ============================================================================
+double meanOf(const Hist1D& hist) {
+
+  const Axis&  x     = hist.GetX();
+  const double width = (x.stop - x.start) / x.num;
+
+  double sum  = 0.;
+  double sumX = 0.;
+  for (std::size_t bin = 1; bin <= x.num; ++bin) {
+    sum  += hist.GetSumW()[bin];
+    sumX += hist.GetSumW()[bin] * (x.start + (bin - 0.5) * width);
+  }
+  return (sum > 0.) ? sumX / sum : 0.;
+
+}  // end 'meanOf(Hist1D&)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  std::vector<std::size_t> mults;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    mults.push_back(std::strtoul(argv[iArg], nullptr, 10));
+  }
+  if (mults.empty()) mults = {512, 2048, 8192};
+
+  // grids from coarse to fine: cell size in y,
+  // no. of cells in phi
+  const std::vector<std::pair<double, std::size_t>> grids = {
+    {0.16, 64},
+    {0.08, 128},
+    {0.04, 256},
+    {0.02, 512}
+  };
+  constexpr std::size_t nEvents = 4;
+
+  CalculatorOptions exactOpt;
+  exactOpt.gridMin    = 0;
+  exactOpt.costPeriod = 0;
+  Calculator exact(exactOpt);
+  exact.Init();
+
+  std::printf("  EEC vs. dR, grid vs. exact, %zu events each\n", nEvents);
+  std::printf(
+    "  %8s %8s %6s %10s %12s %12s %12s %12s %12s\n",
+    "n", "cellY", "nPhi", "max err", "sum diff", "max bin diff", "mean shift", "exact [ms]", "grid [ms]"
+  );
+  for (const std::size_t nPar : mults) {
+
+    std::mt19937                 rng(nPar);
+    std::vector<ParticleColumns> events;
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      events.push_back(makeEvent(nPar, rng));
+    }
+
+    HistogramSet exactHists;
+    const double exactTime = runEvents(exact, events, exactHists);
+    const Hist1D& truth    = findHist(exactHists, "hEECVsDeltaRRec");
+
+    double sumTruth = 0.;
+    double peak     = 0.;
+    for (const double sumw : truth.GetSumW()) {
+      sumTruth += sumw;
+      peak      = std::max(peak, sumw);
+    }
+
+    for (const auto& grid : grids) {
+      CalculatorOptions gridOpt = exactOpt;
+      gridOpt.gridMin   = 1;
+      gridOpt.gridCellY = grid.first;
+      gridOpt.gridNPhi  = grid.second;
+      Calculator approx(gridOpt);
+      approx.Init();
+
+      HistogramSet  gridHists;
+      const double  gridTime = runEvents(approx, events, gridHists);
+      const Hist1D& test     = findHist(gridHists, "hEECVsDeltaRGridRec");
+
+      double sumTest = 0.;
+      double maxDiff = 0.;
+      for (std::size_t bin = 0; bin < test.GetSumW().size(); ++bin) {
+        sumTest += test.GetSumW()[bin];
+        maxDiff  = std::max(maxDiff, std::abs(test.GetSumW()[bin] - truth.GetSumW()[bin]));
+      }
+
+      std::printf(
+        "  %8zu %8.3f %6zu %10.4f %12.2e %12.2e %12.2e %12.2f %12.2f\n",
+        nPar,
+        grid.first,
+        approx.MakeScratch().grid.GetNPhi(),
+        approx.MakeScratch().grid.GetMaxError(),
+        (sumTest - sumTruth) / sumTruth,
+        maxDiff / peak,
+        meanOf(test) - meanOf(truth),
+        exactTime * 1e3,
+        gridTime * 1e3
+      );
+    }
+  }
+  return 0;
+
+}
+
+// end ========================================================================
@@ -0,0 +1,147 @@
+// ============================================================================
+//! \file   SkimCompressionBenchmark.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Compares skim size and read (decompression)
+//! speed of the available page codecs.
+//!
+//! Usage: epnec-bench-skim [input skim] [events per page]
+//!   - without an input skim, synthetic DIS-like
+//!     events are generated
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+// package components
+#include "Skim.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Generate synthetic batches
+// ============================================================================
+std::vector<EventBatch> makeBatches(const std::size_t nBatches, const std::size_t nEvents) {
+
+  std::mt19937                          rng(12345);
+  std::poisson_distribution<int>        mult(12);
+  std::exponential_distribution<float>  ene(0.5);
+  std::uniform_real_distribution<float> unit(-1., 1.);
+  std::uniform_real_distribution<float> logq2(1., 4.6);
+  const int32_t                         species[] = {211, -211, 22, 2212, 321, 2112};
+
+  std::vector<EventBatch> batches(nBatches);
+  uint64_t                event = 0;
+  for (auto& batch : batches) {
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      const float q2 = std::exp(logq2(rng));
+      batch.key.push_back(event++);
+      batch.q2Rec.push_back(q2 * (1.f + 0.05f * unit(rng)));
+      batch.q2Gen.push_back(q2);
+      batch.xbRec.push_back(q2 / 1000.f);
+      batch.xbGen.push_back(q2 / 1000.f);
+      for (auto* pars : {&batch.rec, &batch.gen}) {
+        const int nPars = mult(rng);
+        for (int iPar = 0; iPar < nPars; ++iPar) {
+          const float e = ene(rng);
+          pars->Add(e, e * unit(rng), e * unit(rng), e * unit(rng), species[rng() % 6]);
+        }
+        pars->EndEvent();
+      }
+      for (uint32_t iPar = batch.rec.offsets[iEvent]; iPar < batch.rec.offsets[iEvent + 1]; ++iPar) {
+        batch.recToGen.push_back(static_cast<int32_t>(iPar - batch.rec.offsets[iEvent]));
+      }
+    }
+  }
+  return batches;
+
+}  // end 'makeBatches(std::size_t, std::size_t)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  // get input batches
+  std::vector<EventBatch> batches;
+  if (argc > 1) {
+    SkimReader reader;
+    if (!reader.Open(argv[1])) return 1;
+    batches.resize(reader.NClusters());
+    for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+      reader.Read(iCluster, batches[iCluster]);
+    }
+  } else {
+    batches = makeBatches(16, 4096);
+  }
+  const std::size_t eventsPerPage = (argc > 2) ? std::stoul(argv[2]) : 1;
+
+  std::size_t nEvents = 0;
+  for (const auto& batch : batches) {
+    nEvents += batch.NEvents();
+  }
+
+  // write and read back with each codec
+  const std::vector<std::pair<std::string, Codec>> codecs = {
+    {"none", Codec::None},
+    {"lz4", Codec::LZ4},
+    {"zstd", Codec::Zstd},
+    {"zstd+dict", Codec::ZstdDict}
+  };
+
+  std::printf("  %zu events, %zu events per page\n", nEvents, eventsPerPage);
+  std::printf("  %-10s %14s %14s %8s %14s\n", "codec", "raw [B]", "stored [B]", "ratio", "read [MB/s]");
+  for (const auto& codec : codecs) {
+
+    const std::string path = "epnec-bench-" + codec.first + ".skim";
+    SkimOptions opt;
+    opt.codec         = codec.second;
+    opt.eventsPerPage = eventsPerPage;
+
+    SkimWriter writer(opt);
+    if (!writer.Open(path)) return 1;
+    for (const auto& batch : batches) {
+      writer.Write(batch);
+    }
+    writer.Close();
+
+    // time a full read, best of 3
+    double best = 1e30;
+    for (int iTry = 0; iTry < 3; ++iTry) {
+      SkimReader reader;
+      EventBatch batch;
+      const auto start = std::chrono::steady_clock::now();
+      reader.Open(path);
+      for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+        reader.Read(iCluster, batch);
+      }
+      const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+      best = std::min(best, took.count());
+    }
+
+    std::printf(
+      "  %-10s %14llu %14llu %8.2f %14.1f\n",
+      codec.first.data(),
+      static_cast<unsigned long long>(writer.GetRawBytes()),
+      static_cast<unsigned long long>(writer.GetZipBytes()),
+      static_cast<double>(writer.GetRawBytes()) / writer.GetZipBytes(),
+      writer.GetRawBytes() / best / 1e6
+    );
+    std::remove(path.data());
+  }
+  return 0;
+
+}
+
+// end ========================================================================
@@ -0,0 +1,164 @@
+// ============================================================================
+//! \file   SkimReadBenchmark.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Compares read throughput of the pread and
+//! io_uring skim reader backends on a local file.
+//!
+//! Usage: epnec-bench-read [input skim] [queue depth]
+//!   - without an input skim, a synthetic one is
+//!     written to the current directory (put it on
+//!     the device to test)
+//!   - "cold" reads first drop the file from the
+//!     page cache with posix_fadvise, which needs no
+//!     privileges but only evicts clean pages
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+// posix utilities
+#include <fcntl.h>
+#include <unistd.h>
+// package components
+#include "Skim.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Write a synthetic skim
+// ============================================================================
+bool writeSkim(const std::string& path, const std::size_t nBatches, const std::size_t nEvents) {
+
+  std::mt19937                          rng(12345);
+  std::poisson_distribution<int>        mult(12);
+  std::exponential_distribution<float>  ene(0.5);
+  std::uniform_real_distribution<float> unit(-1., 1.);
+
+  SkimWriter writer;
+  if (!writer.Open(path)) return false;
+
+  EventBatch batch;
+  uint64_t   event = 0;
+  for (std::size_t iBatch = 0; iBatch < nBatches; ++iBatch) {
+    batch.Clear();
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      batch.key.push_back(event++);
+      batch.q2Rec.push_back(10.f);
+      batch.q2Gen.push_back(10.f);
+      batch.xbRec.push_back(0.01f);
+      batch.xbGen.push_back(0.01f);
+      for (auto* pars : {&batch.rec, &batch.gen}) {
+        const int nPars = mult(rng);
+        for (int iPar = 0; iPar < nPars; ++iPar) {
+          const float e = ene(rng);
+          pars->Add(e, e * unit(rng), e * unit(rng), e * unit(rng), 211);
+        }
+        pars->EndEvent();
+      }
+      for (uint32_t iPar = batch.rec.offsets[iEvent]; iPar < batch.rec.offsets[iEvent + 1]; ++iPar) {
+        batch.recToGen.push_back(-1);
+      }
+    }
+    writer.Write(batch);
+  }
+  return writer.Close();
+
+}  // end 'writeSkim(std::string&, std::size_t, std::size_t)'
+
+
+
+// ============================================================================
+//! Drop a file from the page cache
+// ============================================================================
+void evict(const std::string& path) {
+
+  const int fd = ::open(path.data(), O_RDONLY);
+  if (fd < 0) return;
+  ::fdatasync(fd);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+
+}  // end 'evict(std::string&)'
+
+
+
+// ============================================================================
+//! Time a full read of a skim, best of nTries
+// ============================================================================
+double timeRead(const std::string& path, const SkimReaderOptions& opt, const bool cold, const int nTries, uint64_t& bytes) {
+
+  double best = 1e30;
+  for (int iTry = 0; iTry < nTries; ++iTry) {
+    if (cold) evict(path);
+
+    SkimReader reader(opt);
+    EventBatch batch;
+    const auto start = std::chrono::steady_clock::now();
+    if (!reader.Open(path)) return -1.;
+    for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+      reader.Read(iCluster, batch);
+    }
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    best  = std::min(best, took.count());
+    bytes = reader.GetBytesRead();
+  }
+  return best;
+
+}  // end 'timeRead(std::string&, SkimReaderOptions&, bool, int, uint64_t&)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  // get input skim
+  const bool        own   = (argc < 2);
+  const std::string path  = own ? "epnec-bench-read.skim" : argv[1];
+  const unsigned    depth = (argc > 2) ? std::stoul(argv[2]) : 256;
+  if (own && !writeSkim(path, 64, 4096)) return 1;
+
+  // read with each backend
+  SkimReaderOptions pread;
+  SkimReaderOptions uring;
+  pread.backend    = ReadBackend::Pread;
+  uring.backend    = ReadBackend::Uring;
+  uring.queueDepth = depth;
+
+  const std::vector<std::pair<std::string, SkimReaderOptions>> backends = {
+    {"pread", pread},
+    {"io_uring", uring}
+  };
+
+  std::printf("  '%s', io_uring queue depth %u\n", path.data(), depth);
+  std::printf("  %-10s %14s %16s %16s\n", "backend", "read [B]", "cold [MB/s]", "warm [MB/s]");
+  for (const auto& backend : backends) {
+    uint64_t     bytes = 0;
+    const double cold  = timeRead(path, backend.second, true, 3, bytes);
+    const double warm  = timeRead(path, backend.second, false, 3, bytes);
+    if ((cold < 0.) || (warm < 0.)) return 1;
+
+    std::printf(
+      "  %-10s %14llu %16.1f %16.1f\n",
+      backend.first.data(),
+      static_cast<unsigned long long>(bytes),
+      bytes / cold / 1e6,
+      bytes / warm / 1e6
+    );
+  }
+
+  if (own) std::remove(path.data());
+  return 0;
+
+}
+
+// end ========================================================================
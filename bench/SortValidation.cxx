@@ -0,0 +1,193 @@
+// ============================================================================
+//! \file   SortValidation.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Checks sorting and joining of skims on the event
+//! key, with and without matching indices (e.g. an
+//! extraction in association mode, or a skim
+//! written before they were filled).
+//!
+//! Usage: epnec-bench-sort [no. of clusters] [events per cluster]
+//!   - sorts shuffled batches in memory, then a
+//!     skim of shuffled clusters on disk, and joins
+//!     the sorted skim with itself
+//!   - checks that keys come out in order, that
+//!     recToGen stays one per rec particle and
+//!     follows its event, and reports the time of
+//!     the on-disk sort
+//!   - returns non-zero if any check fails
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+// package components
+#include "SortedSkim.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Make a batch of events with shuffled keys
+// ============================================================================
+//! With matches, each rec particle's index is the
+//! low bits of its event's key, so it can be traced
+//! through the sort; without, recToGen is empty.
+EventBatch makeBatch(const std::size_t nEvents, const bool withMatches, uint64_t& nextKey, std::mt19937& rng) {
+
+  std::poisson_distribution<int> mult(4);
+
+  std::vector<uint64_t> keys(nEvents);
+  std::iota(keys.begin(), keys.end(), nextKey);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  nextKey += nEvents;
+
+  EventBatch batch;
+  for (const uint64_t key : keys) {
+    batch.key.push_back(key);
+    batch.q2Rec.push_back(10.f);
+    batch.q2Gen.push_back(10.f);
+    batch.xbRec.push_back(0.1f);
+    batch.xbGen.push_back(0.1f);
+    for (auto* pars : {&batch.rec, &batch.gen}) {
+      const int nPars = mult(rng);
+      for (int iPar = 0; iPar < nPars; ++iPar) {
+        pars->Add(1.f, 0.f, 0.f, -1.f, 211);
+      }
+      pars->EndEvent();
+    }
+    if (!withMatches) continue;
+    batch.recToGen.insert(batch.recToGen.end(), batch.rec.View(batch.NEvents() - 1).size, static_cast<int32_t>(key % 1000));
+  }
+  return batch;
+
+}  // end 'makeBatch(std::size_t, bool, uint64_t&, std::mt19937&)'
+
+
+
+// ============================================================================
+//! Check a batch is sorted and its indices line up
+// ============================================================================
+//! matches: 1 if indices should follow their event,
+//! 0 if they should all be -1.
+bool checkBatch(const EventBatch& batch, const int matches) {
+
+  bool good = std::is_sorted(batch.key.begin(), batch.key.end());
+  good = good && (batch.recToGen.size() == batch.rec.Size());
+  for (std::size_t iEvent = 0; good && (iEvent < batch.NEvents()); ++iEvent) {
+    const int32_t expect = matches ? static_cast<int32_t>(batch.key[iEvent] % 1000) : -1;
+    for (uint32_t iPar = batch.rec.offsets[iEvent]; iPar < batch.rec.offsets[iEvent + 1]; ++iPar) {
+      good = good && (batch.recToGen[iPar] == expect);
+    }
+  }
+  return good;
+
+}  // end 'checkBatch(EventBatch&, int)'
+
+
+
+// ============================================================================
+//! Report a check
+// ============================================================================
+bool report(const std::string& what, const bool good) {
+
+  std::printf("    %-30s %s\n", what.data(), good ? "ok" : "FAILED");
+  return good;
+
+}  // end 'report(std::string&, bool)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  const std::size_t nClusters = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 64;
+  const std::size_t nEvents   = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+  std::mt19937 rng(12345);
+  bool         good = true;
+
+  std::printf("  sorting %zu clusters of %zu events\n", nClusters, nEvents);
+  for (const int matches : {0, 1}) {
+    const std::string with = matches ? " with matches" : " without matches";
+
+    // in memory
+    uint64_t   nextKey = 0;
+    EventBatch batch   = makeBatch(nEvents, matches, nextKey, rng);
+    SortBatch(batch);
+    good = report("batch" + with, checkBatch(batch, matches)) && good;
+
+    // on disk: cluster keys interleave, so the
+    // merge has to do real work
+    const std::string unsorted = "epnec-bench-sort.runs";
+    const std::string sorted   = "epnec-bench-sort.skim";
+    SkimWriter writer;
+    if (!writer.Open(unsorted)) return 1;
+    for (std::size_t iCluster = 0; iCluster < nClusters; ++iCluster) {
+      uint64_t   first = iCluster % 2;
+      EventBatch part  = makeBatch(nEvents, matches, first, rng);
+      for (auto& key : part.key) {
+        key = key * nClusters + iCluster;
+      }
+      if (matches) {
+        for (std::size_t iEvent = 0; iEvent < part.NEvents(); ++iEvent) {
+          std::fill(
+            part.recToGen.begin() + part.rec.offsets[iEvent],
+            part.recToGen.begin() + part.rec.offsets[iEvent + 1],
+            static_cast<int32_t>(part.key[iEvent] % 1000)
+          );
+        }
+      }
+      SortBatch(part);
+      writer.Write(part);
+    }
+    writer.Close();
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool merged = SortSkim(unsorted, sorted, SkimOptions(), nEvents, 4);
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+
+    EventBatch all;
+    SkimReader reader;
+    const bool opened = merged && reader.Open(sorted);
+    for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+      EventBatch part;
+      reader.Read(iCluster, part);
+      for (std::size_t iEvent = 0; iEvent < part.NEvents(); ++iEvent) {
+        all.AddEvent(part, iEvent);
+      }
+    }
+    reader.Close();
+    const bool complete = opened && (all.NEvents() == nClusters * nEvents);
+    good = report("skim" + with, complete && checkBatch(all, matches)) && good;
+    std::printf("      sorted in %.3f s\n", took.count());
+
+    // joined events can't keep indices, as they
+    // point into the other skim's particles
+    SkimJoiner joiner;
+    EventBatch joined;
+    bool       joinGood = joiner.Open(sorted, sorted);
+    while (joinGood && joiner.Next(joined, nEvents)) {
+      joinGood = checkBatch(joined, 0);
+    }
+    joinGood = joinGood && (joiner.NJoined() == nClusters * nEvents);
+    good     = report("join" + with, joinGood) && good;
+
+    std::remove(unsorted.data());
+    std::remove(sorted.data());
+  }
+  return good ? 0 : 1;
+
+}
+
+// end ========================================================================
@@ -0,0 +1,123 @@
+// ============================================================================
+//! \file   StartupBenchmark.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Reports start-up time and footprint of each
+//! library target, by running its probe
+//! (epnec-probe-core, epnec-probe-root) repeatedly.
+//!
+//! Usage: epnec-bench-startup [probe ...]
+//!   - without arguments, the probes next to this
+//!     executable are run (missing ones skipped,
+//!     e.g. in a core-only build)
+//!   - start-up is wall time from spawn to exit, so
+//!     includes loading and relocating libraries
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+// posix utilities
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+
+
+// ============================================================================
+//! Run a probe once, returns wall time in s (< 0 on failure)
+// ============================================================================
+double timeProbe(const std::string& probe) {
+
+  char* const args[] = {const_cast<char*>(probe.data()), nullptr};
+  const auto  start  = std::chrono::steady_clock::now();
+
+  pid_t pid = 0;
+  if (::posix_spawn(&pid, probe.data(), nullptr, nullptr, args, environ) != 0) return -1.;
+
+  int status = 0;
+  if ((::waitpid(pid, &status, 0) < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) return -1.;
+
+  const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+  return took.count();
+
+}  // end 'timeProbe(std::string&)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  // get probes
+  std::vector<std::string> probes(argv + 1, argv + argc);
+  if (probes.empty()) {
+    const std::string self = argv[0];
+    const std::string dir  = (self.rfind('/') != std::string::npos) ? self.substr(0, self.rfind('/') + 1) : "./";
+    for (const std::string target : {"core", "root"}) {
+      const std::string probe = dir + "epnec-probe-" + target;
+      if (::access(probe.data(), X_OK) == 0) probes.push_back(probe);
+    }
+  }
+  if (probes.empty()) {
+    std::fprintf(stderr, "PANIC: no probes to run!\n");
+    return 1;
+  }
+
+  constexpr int nRuns = 20;
+  std::printf("  start-up over %d runs\n", nRuns);
+  std::printf("  %-28s %10s %10s %6s %12s %10s %10s\n", "probe", "min [ms]", "med [ms]", "libs", "libs [MB]", "rss [MB]", "exe [kB]");
+  for (const auto& probe : probes) {
+
+    // warm the page cache first, so runs compare
+    // loading rather than reading from disk
+    std::vector<double> times;
+    if (timeProbe(probe) < 0.) {
+      std::fprintf(stderr, "WARNING: couldn't run '%s'\n", probe.data());
+      continue;
+    }
+    for (int iRun = 0; iRun < nRuns; ++iRun) {
+      const double took = timeProbe(probe);
+      if (took >= 0.) times.push_back(took);
+    }
+    if (times.empty()) continue;
+    std::sort(times.begin(), times.end());
+
+    // mapped libraries and resident memory
+    unsigned long      nLibs = 0;
+    unsigned long long bytes = 0;
+    unsigned long long rss   = 0;
+    FILE*              pipe  = ::popen((probe + " --footprint").data(), "r");
+    if (pipe) {
+      if (std::fscanf(pipe, "libs %lu bytes %llu rss %llu", &nLibs, &bytes, &rss) != 3) nLibs = 0;
+      ::pclose(pipe);
+    }
+
+    struct stat info;
+    const double exe = (::stat(probe.data(), &info) == 0) ? info.st_size / 1024. : 0.;
+
+    const std::string name = probe.substr(probe.rfind('/') + 1);
+    std::printf(
+      "  %-28s %10.2f %10.2f %6lu %12.1f %10.1f %10.1f\n",
+      name.data(),
+      times.front() * 1e3,
+      times[times.size() / 2] * 1e3,
+      nLibs,
+      bytes / 1048576.,
+      rss / 1048576.,
+      exe
+    );
+  }
+  return 0;
+
+}
+
+// end ========================================================================
@@ -0,0 +1,92 @@
+// ============================================================================
+//! \file   StartupProbe.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Smallest useful job on one library target: books
+//! the Calculator's histograms and exits. Built once
+//! against the core and once against the ROOT
+//! library (with EPNEC_PROBE_ROOT), and run by
+//! epnec-bench-startup.
+//!
+//! Usage: epnec-probe-<target> [--footprint]
+//!   --footprint  print the no. and size of shared
+//!                libraries mapped, and resident
+//!                memory
+// ============================================================================
+
+// c++ utilities
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+// posix utilities
+#include <sys/stat.h>
+// package components
+#include "Calculator.hxx"
+#ifdef EPNEC_PROBE_ROOT
+#include "HistogramWriter.hxx"
+#endif
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Print shared libraries mapped and resident memory
+// ============================================================================
+void printFootprint() {
+
+  // n.b. a library is mapped several times (text,
+  // data, ...), so count each file once
+  std::set<std::string> libs;
+  std::ifstream         maps("/proc/self/maps");
+  std::string           line;
+  while (std::getline(maps, line)) {
+    const std::size_t slash = line.find('/');
+    if ((slash != std::string::npos) && (line.find(".so", slash) != std::string::npos)) {
+      libs.insert(line.substr(slash));
+    }
+  }
+
+  unsigned long long bytes = 0;
+  for (const auto& lib : libs) {
+    struct stat info;
+    if (::stat(lib.data(), &info) == 0) bytes += info.st_size;
+  }
+
+  unsigned long long rss = 0;
+  std::ifstream      status("/proc/self/status");
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmRSS:") == 0) rss = std::strtoull(line.data() + 6, nullptr, 10);
+  }
+  std::printf("libs %zu bytes %llu rss %llu\n", libs.size(), bytes, rss * 1024);
+
+}  // end 'printFootprint()'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  CalculatorOptions opt;
+  opt.costPeriod = 0;
+
+  Calculator calc(opt);
+#ifdef EPNEC_PROBE_ROOT
+  calc.SetWriter(WriteHistograms);
+#endif
+  calc.Init();
+
+  if ((argc > 1) && (std::strcmp(argv[1], "--footprint") == 0)) {
+    printFootprint();
+  }
+  return 0;
+
+}
+
+// end ========================================================================
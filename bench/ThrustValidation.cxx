@@ -0,0 +1,185 @@
+// ============================================================================
+//! \file   ThrustValidation.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Validates the seeded thrust axis search of the
+//! EventShapeCalculator against the exact search,
+//! on synthetic current hemispheres of 1-3 jets.
+//!
+//! Usage: epnec-bench-thrust [no. of events] [max particles]
+//!   - reports the fraction of events where the
+//!     seeded search misses the exact maximum, the
+//!     largest and mean relative deficit in T over
+//!     those, and the time per event of each
+//!   - defaults to 10^4 events of 3-40 particles
+// ============================================================================
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+// package components
+#include "EventShapes.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ============================================================================
+//! Make a synthetic current hemisphere of nPar massless particles
+// ============================================================================
+//! Particles are spread evenly over nJets jets,
+//! gaussian in angle around random axes, and
+//! flipped into pz < 0 where they stray out.
+ParticleColumns makeEvent(const std::size_t nPar, const std::size_t nJets, std::mt19937& rng) {
+
+  std::uniform_real_distribution<double> flatCos(-1., 0.);
+  std::uniform_real_distribution<double> flatPhi(-3.14159265358979, 3.14159265358979);
+  std::exponential_distribution<double>  energy(0.5);
+  std::normal_distribution<double>       spread(0., 0.25);
+
+  std::vector<double> axisX(nJets);
+  std::vector<double> axisY(nJets);
+  std::vector<double> axisZ(nJets);
+  for (std::size_t iJet = 0; iJet < nJets; ++iJet) {
+    const double cosTh = flatCos(rng);
+    const double sinTh = std::sqrt(1. - cosTh * cosTh);
+    const double phi   = flatPhi(rng);
+    axisX[iJet] = sinTh * std::cos(phi);
+    axisY[iJet] = sinTh * std::sin(phi);
+    axisZ[iJet] = cosTh;
+  }
+
+  ParticleColumns event;
+  for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+    const std::size_t iJet = iPar % nJets;
+    double dx = axisX[iJet] + spread(rng);
+    double dy = axisY[iJet] + spread(rng);
+    double dz = axisZ[iJet] + spread(rng);
+    const double norm = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const double e    = energy(rng) + 0.1;
+    dx *= e / norm;
+    dy *= e / norm;
+    dz *= e / norm;
+    event.Add(e, dx, dy, -std::abs(dz), 211);
+  }
+  event.offsets.push_back(event.Size());
+  return event;
+
+}  // end 'makeEvent(std::size_t, std::size_t, std::mt19937&)'
+
+
+
+// ============================================================================
+//! Exact thrust of the pz < 0 particles of an event
+// ============================================================================
+//! The thrust axis is normal to a plane through two
+//! particle momenta, so T is the largest |sum of
+//! +-p| over the partitions such planes make, with
+//! both signs tried for the two particles in the
+//! plane. O(N^3).
+double exactThrust(const ParticleView& pars) {
+
+  std::vector<double> px;
+  std::vector<double> py;
+  std::vector<double> pz;
+  double sumP = 0.;
+  for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+    if (!(pars.pz[iPar] < 0.f)) continue;
+    px.push_back(pars.px[iPar]);
+    py.push_back(pars.py[iPar]);
+    pz.push_back(pars.pz[iPar]);
+    sumP += std::sqrt(px.back() * px.back() + py.back() * py.back() + pz.back() * pz.back());
+  }
+
+  const std::size_t nPar = px.size();
+  if (nPar < 2) return 1.;
+
+  double best = 0.;
+  for (std::size_t i = 0; i < nPar; ++i) {
+    for (std::size_t j = i + 1; j < nPar; ++j) {
+      const double nx = py[i] * pz[j] - pz[i] * py[j];
+      const double ny = pz[i] * px[j] - px[i] * pz[j];
+      const double nz = px[i] * py[j] - py[i] * px[j];
+
+      double sx = 0.;
+      double sy = 0.;
+      double sz = 0.;
+      for (std::size_t k = 0; k < nPar; ++k) {
+        if ((k == i) || (k == j)) continue;
+        const double sign = (px[k] * nx + py[k] * ny + pz[k] * nz >= 0.) ? 1. : -1.;
+        sx += sign * px[k];
+        sy += sign * py[k];
+        sz += sign * pz[k];
+      }
+      for (const double si : {-1., 1.}) {
+        for (const double sj : {-1., 1.}) {
+          const double tx = sx + si * px[i] + sj * px[j];
+          const double ty = sy + si * py[i] + sj * py[j];
+          const double tz = sz + si * pz[i] + sj * pz[j];
+          best = std::max(best, std::sqrt(tx * tx + ty * ty + tz * tz));
+        }
+      }
+    }
+  }
+  return std::min(best / sumP, 1.);
+
+}  // end 'exactThrust(ParticleView&)'
+
+
+
+// ============================================================================
+//! Main
+// ============================================================================
+int main(int argc, char* argv[]) {
+
+  const std::size_t nEvents = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+  const std::size_t maxPar  = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 40;
+
+  std::mt19937                               rng(12345);
+  std::uniform_int_distribution<std::size_t> nPars(3, std::max<std::size_t>(3, maxPar));
+  std::uniform_int_distribution<std::size_t> nJets(1, 3);
+
+  EventShapeCalculator calculator;
+  EventShapes          shapes;
+  std::size_t          nMissed  = 0;
+  double               maxShort = 0.;
+  double               sumShort = 0.;
+  double               fastTime = 0.;
+  double               slowTime = 0.;
+  for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+    const ParticleColumns event = makeEvent(nPars(rng), nJets(rng), rng);
+
+    // n.b. Q = 1 keeps every event's shapes valid
+    const auto   start = std::chrono::steady_clock::now();
+    calculator.Compute(event.View(0), 1., shapes);
+    const auto   split = std::chrono::steady_clock::now();
+    const double exact = exactThrust(event.View(0));
+    const auto   stop  = std::chrono::steady_clock::now();
+    fastTime += std::chrono::duration<double>(split - start).count();
+    slowTime += std::chrono::duration<double>(stop - split).count();
+
+    const double shortBy = (exact - (1. - shapes.tauC)) / exact;
+    if (shortBy > 1e-9) {
+      ++nMissed;
+      maxShort  = std::max(maxShort, shortBy);
+      sumShort += shortBy;
+    }
+  }
+
+  std::printf("  thrust, seeded vs. exact search, %zu events of 3-%zu particles\n", nEvents, maxPar);
+  std::printf("    missed exact maximum:   %zu (%.3f%%)\n", nMissed, 100. * nMissed / std::max<std::size_t>(1, nEvents));
+  std::printf("    max deficit in T:       %.3e\n", maxShort);
+  std::printf("    mean deficit if missed: %.3e\n", (nMissed > 0) ? sumShort / nMissed : 0.);
+  std::printf("    seeded [us/event]:      %.2f\n", 1e6 * fastTime / std::max<std::size_t>(1, nEvents));
+  std::printf("    exact [us/event]:       %.2f\n", 1e6 * slowTime / std::max<std::size_t>(1, nEvents));
+  return 0;
+
+}
+
+// end ========================================================================
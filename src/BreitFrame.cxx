@@ -0,0 +1,122 @@
+// ============================================================================
+//! \file   BreitFrame.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Lorentz transformation into the Breit frame
+//! from beam and scattered electron momenta.
+// ============================================================================
+
+#include "BreitFrame.hxx"
+
+// c++ utilities
+#include <cmath>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Build transformation for an event
+  // --------------------------------------------------------------------------
+  //! Returns false if the kinematics are unphysical
+  //! (Q2 <= 0 or x outside (0, 1]).
+  bool BreitFrame::Build(const FourVector& eBeam, const FourVector& pBeam, const FourVector& eScat) {
+
+    // inclusive kinematics
+    const FourVector q  = eBeam - eScat;
+    const double     pq = pBeam.Dot(q);
+    m_q2 = -q.Dot(q);
+    if (!(m_q2 > 0.) || !(pq > 0.)) return false;
+
+    m_xb = m_q2 / (2. * pq);
+    if (!(m_xb > 0.) || (m_xb > 1. + 1e-6)) return false;
+
+    // boost: rest frame of q + 2xP
+    const FourVector v     = q + pBeam * (2. * m_xb);
+    const double     bx    = v.px / v.e;
+    const double     by    = v.py / v.e;
+    const double     bz    = v.pz / v.e;
+    const double     beta2 = bx * bx + by * by + bz * bz;
+    if (!(beta2 < 1.)) return false;
+
+    const double gamma   = 1. / std::sqrt(1. - beta2);
+    const double beta[3] = {bx, by, bz};
+
+    double boost[4][4];
+    boost[0][0] = gamma;
+    for (int i = 0; i < 3; ++i) {
+      boost[0][i + 1] = -gamma * beta[i];
+      boost[i + 1][0] = -gamma * beta[i];
+      for (int j = 0; j < 3; ++j) {
+        const double delta = (i == j) ? 1. : 0.;
+        boost[i + 1][j + 1] = delta + ((beta2 > 0.) ? (gamma - 1.) * beta[i] * beta[j] / beta2 : 0.);
+      }
+    }
+    // n.b. boost alone first, to find the axes
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        m_lambda[i][j] = boost[i][j];
+      }
+    }
+
+    // rotation: photon to -z, scattered electron to phi = 0
+    const FourVector qB = Transform(q);
+    const FourVector kB = Transform(eScat);
+
+    double       ez[3] = {-qB.px, -qB.py, -qB.pz};
+    const double nz    = std::sqrt(ez[0] * ez[0] + ez[1] * ez[1] + ez[2] * ez[2]);
+    if (!(nz > 0.)) return false;
+    for (double& c : ez) c /= nz;
+
+    double       ex[3] = {kB.px, kB.py, kB.pz};
+    const double proj  = ex[0] * ez[0] + ex[1] * ez[1] + ex[2] * ez[2];
+    for (int i = 0; i < 3; ++i) ex[i] -= proj * ez[i];
+    const double nx = std::sqrt(ex[0] * ex[0] + ex[1] * ex[1] + ex[2] * ex[2]);
+    if (nx > 0.) {
+      for (double& c : ex) c /= nx;
+    } else {
+      // electron along the axis: any perpendicular will do
+      const double other[3] = {(std::abs(ez[0]) < 0.9) ? 1. : 0., (std::abs(ez[0]) < 0.9) ? 0. : 1., 0.};
+      const double dot      = other[0] * ez[0] + other[1] * ez[1] + other[2] * ez[2];
+      for (int i = 0; i < 3; ++i) ex[i] = other[i] - dot * ez[i];
+      const double norm = std::sqrt(ex[0] * ex[0] + ex[1] * ex[1] + ex[2] * ex[2]);
+      for (double& c : ex) c /= norm;
+    }
+    const double ey[3] = {
+      ez[1] * ex[2] - ez[2] * ex[1],
+      ez[2] * ex[0] - ez[0] * ex[2],
+      ez[0] * ex[1] - ez[1] * ex[0]
+    };
+
+    // lambda = rotation x boost
+    const double* rows[3] = {ex, ey, ez};
+    for (int j = 0; j < 4; ++j) {
+      m_lambda[0][j] = boost[0][j];
+      for (int i = 0; i < 3; ++i) {
+        m_lambda[i + 1][j] = rows[i][0] * boost[1][j] + rows[i][1] * boost[2][j] + rows[i][2] * boost[3][j];
+      }
+    }
+    return true;
+
+  }  // end 'Build(FourVector& x 3)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Transform a four-vector into the Breit frame
+  // --------------------------------------------------------------------------
+  FourVector BreitFrame::Transform(const FourVector& p) const {
+
+    const double in[4] = {p.e, p.px, p.py, p.pz};
+    double       out[4];
+    for (int i = 0; i < 4; ++i) {
+      out[i] = m_lambda[i][0] * in[0] + m_lambda[i][1] * in[1] + m_lambda[i][2] * in[2] + m_lambda[i][3] * in[3];
+    }
+    return {out[0], out[1], out[2], out[3]};
+
+  }  // end 'Transform(FourVector&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,73 @@
+// ============================================================================
+//! \file   BreitFrame.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Lorentz transformation into the Breit frame
+//! from beam and scattered electron momenta.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_BreitFrame_hxx
+#define EPNucleonEnergyCorrelator_BreitFrame_hxx
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Minimal four-vector
+  // ==========================================================================
+  struct FourVector {
+    double e  = 0.;  //!< energy
+    double px = 0.;  //!< x momentum
+    double py = 0.;  //!< y momentum
+    double pz = 0.;  //!< z momentum
+
+    FourVector operator+(const FourVector& o) const {return {e + o.e, px + o.px, py + o.py, pz + o.pz};}
+    FourVector operator-(const FourVector& o) const {return {e - o.e, px - o.px, py - o.py, pz - o.pz};}
+    FourVector operator*(const double s) const {return {e * s, px * s, py * s, pz * s};}
+    double     Dot(const FourVector& o) const {return e * o.e - px * o.px - py * o.py - pz * o.pz;}
+  };
+
+
+
+  // ==========================================================================
+  //! Breit frame
+  // --------------------------------------------------------------------------
+  //! Built from the electron and proton beams and
+  //! the scattered electron: boosts to the rest
+  //! frame of q + 2 x P (where q = -2 x P), then
+  //! rotates the photon onto -z, so the proton
+  //! goes to +z, and the scattered electron to
+  //! phi = 0.
+  // ==========================================================================
+  class BreitFrame {
+
+    public:
+
+      // ctor/dtor
+      BreitFrame()  {};
+      ~BreitFrame() {};
+
+      // interface
+      bool       Build(const FourVector& eBeam, const FourVector& pBeam, const FourVector& eScat);
+      FourVector Transform(const FourVector& p) const;
+
+      // getters
+      double GetQ2() const {return m_q2;}
+      double GetXB() const {return m_xb;}
+
+    private:
+
+      // members
+      double m_q2 = 0.;
+      double m_xb = 0.;
+      double m_lambda[4][4] = {{0.}};
+
+  };  // end BreitFrame
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -3,12 +3,249 @@
 //! \author Derek Anderson
 //! \date   07.11.2025
 // ----------------------------------------------------------------------------
-//! Calculates NEC and saves them to an RNTuple for
-//! histogramming downstream.
+//! Calculates NEC and saves them to histograms
+//! for analysis downstream.
 // ============================================================================
 
 #include "Calculator.hxx"
 
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+// package components
+#include "Skim.hxx"
+#include "SortedSkim.hxx"
+
+
+
+namespace {
+
+  using namespace EPNucleonEnergyCorrelator;
+
+  // no. of azimuthal harmonics
+  constexpr std::size_t NHarmonics = 6;
+
+  constexpr float Pi = 3.14159265358979f;
+
+  // binning definitions
+  const std::map<std::string, Axis> Axes = {
+    {"ene", {"E [GeV]", 201, -1., 200.}},
+    {"ang", {"#theta_{breit} [rad]", 90, -3.15, 3.15}},
+    {"rap", {"y = ln tan(#theta/2)", 200, -15., 5.}},
+    {"angLab", {"#theta_{lab} [rad]", 90, -3.15, 3.15}},
+    {"rapLab", {"y_{lab} = ln tan(#theta_{lab}/2)", 200, -10., 10.}},
+    {"weight", {"E/E_{p}", 21, -0.1, 2.}},
+    {"x", {"x_{B}", 21, -0.1, 2.}},
+    {"lnx", {"ln x_{B}", 300, -20., 10.}},
+    {"q", {"Q^{2} [GeV/c]^{2}", 101, -10., 1000}},
+    {"lnq", {"ln Q^{2}", 51, -1., 50.}},
+    {"chi", {"#chi [rad]", 100, 0., 3.1416}},
+    {"dR", {"#DeltaR = #sqrt{#Deltay^{2} + #Delta#phi^{2}}", 200, 0., 20.}},
+    {"kernel", {"EEC kernel (exact, grid)", 2, 0.5, 2.5}},
+    {"tauQ", {"#tau_{Q}", 100, 0., 1.}},
+    {"tauC", {"#tau_{C}", 100, 0., 1.}},
+    {"bQ", {"B_{Q}", 100, 0., 1.}},
+    {"rho", {"#rho", 100, 0., 1.}},
+    {"gap", {"#Deltay_{max}", 80, 0., 20.}},
+    {"xE", {"x_{E} = 2E_{lead}/Q", 60, 0., 1.5}},
+    {"species", {"leading hadron (#pi, K, p, other)", 4, 0.5, 4.5}},
+    {"rank", {"rank", NLeading, 0.5, NLeading + 0.5}},
+    {"harm", {"n", NHarmonics, 0.5, NHarmonics + 0.5}}
+  };
+
+  // create histogram title
+  std::string makeTitle(
+    const std::string& x,
+    const std::string& y = "",
+    const std::string& z = "",
+    const std::string& t = ""
+  ) {
+    return t + ";" + x + ";" + y + ";" + z;
+  }
+
+  // create a 1d histogram
+  Hist1D makeHist1D(const std::string& axis, const std::string& name, const std::string& ytitle = "") {
+    const Axis& x = Axes.at(axis);
+    return Hist1D(name, makeTitle(x.title, ytitle), x);
+  }
+
+  // create a 2d histogram
+  Hist2D makeHist2D(const std::string& xaxis, const std::string& yaxis, const std::string& name) {
+    const Axis& x = Axes.at(xaxis);
+    const Axis& y = Axes.at(yaxis);
+    return Hist2D(name, makeTitle(x.title, y.title), x, y);
+  }
+
+  // fill eec vs. chi and dR of pairs (i, j > i) with
+  // i in [iBegin, iEnd) and j in [jBegin, jEnd) of
+  // the event starting at first
+  void fillPairTile(
+    const Calculator::PairInputs& in,
+    const std::size_t first,
+    const std::size_t iBegin,
+    const std::size_t iEnd,
+    const std::size_t jBegin,
+    const std::size_t jEnd,
+    Hist1D& chi,
+    Hist1D& dR
+  ) {
+    const float* nx  = in.nx.data() + first;
+    const float* ny  = in.ny.data() + first;
+    const float* nz  = in.nz.data() + first;
+    const float* y   = in.y.data() + first;
+    const float* phi = in.phi.data() + first;
+    const float* w   = in.w.data() + first;
+    for (std::size_t iPar = iBegin; iPar < iEnd; ++iPar) {
+      for (std::size_t jPar = std::max(jBegin, iPar + 1); jPar < jEnd; ++jPar) {
+        const float cosChi = nx[iPar] * nx[jPar] + ny[iPar] * ny[jPar] + nz[iPar] * nz[jPar];
+        const float dY     = y[iPar] - y[jPar];
+        const float dPhi   = std::abs(phi[iPar] - phi[jPar]);
+        const float wrap   = (dPhi > Pi) ? 2.f * Pi - dPhi : dPhi;
+        chi.Fill(std::acos(std::clamp(cosChi, -1.f, 1.f)), w[iPar] * w[jPar]);
+        dR.Fill(std::sqrt(dY * dY + wrap * wrap), w[iPar] * w[jPar]);
+      }
+    }
+  }
+
+  // unit vectors, rapidities, azimuths and
+  // normalized energies of a stream of events'
+  // particles, in one pass over the stream; an
+  // event has pairs to weight if it has 2+
+  // particles and sumE > 0
+  // n.b. rapidities are taken from the particle
+  // stream and clamped to the range of the
+  // rapidity histograms, so particles along the
+  // beam have a finite dR
+  void pairInputs(
+    const ParticleView& pars,
+    const uint32_t* offsets,
+    const std::size_t nEvents,
+    const Calculator::ParticleStream& stream,
+    Calculator::PairInputs& in
+  ) {
+    in.sumE.resize(nEvents);
+    in.eventE.resize(pars.size);
+    SegmentedSum(offsets, nEvents, pars.energy, in.sumE.data());
+    Broadcast(offsets, nEvents, in.sumE.data(), in.eventE.data());
+
+    in.nx.resize(pars.size);
+    in.ny.resize(pars.size);
+    in.nz.resize(pars.size);
+    in.y.resize(pars.size);
+    in.phi.resize(pars.size);
+    in.w.resize(pars.size);
+
+    const Axis& rap = Axes.at("rap");
+    for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+      const float norm = std::sqrt(pars.px[iPar] * pars.px[iPar] + pars.py[iPar] * pars.py[iPar] + pars.pz[iPar] * pars.pz[iPar]);
+      const float inv  = (norm > 0.f) ? 1.f / norm : 0.f;
+      in.nx[iPar]  = pars.px[iPar] * inv;
+      in.ny[iPar]  = pars.py[iPar] * inv;
+      in.nz[iPar]  = pars.pz[iPar] * inv;
+      in.w[iPar]   = (in.eventE[iPar] > 0.) ? static_cast<float>(pars.energy[iPar] / in.eventE[iPar]) : 0.f;
+      in.y[iPar]   = static_cast<float>(std::clamp(stream.y[iPar], rap.start, rap.stop));
+      in.phi[iPar] = std::atan2(pars.py[iPar], pars.px[iPar]);
+    }
+  }
+
+  // cos/sin(n phi) for n = 1..NHarmonics of nPar
+  // particles, by recurrence from cos/sin(phi) =
+  // px/pT, py/pT; harmonic n of particle i goes to
+  // [(n - 1) * nPar + i]. Particles with pT = 0 get
+  // zeros.
+  void harmonics(const float* px, const float* py, const std::size_t nPar, float* cosN, float* sinN) {
+    for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+      const float pt2 = px[iPar] * px[iPar] + py[iPar] * py[iPar];
+      const float inv = (pt2 > 0.f) ? 1.f / std::sqrt(pt2) : 0.f;
+      cosN[iPar] = px[iPar] * inv;
+      sinN[iPar] = py[iPar] * inv;
+    }
+    for (std::size_t iHarm = 1; iHarm < NHarmonics; ++iHarm) {
+      const float* cosPrev = cosN + (iHarm - 1) * nPar;
+      const float* sinPrev = sinN + (iHarm - 1) * nPar;
+      float*       cosNext = cosN + iHarm * nPar;
+      float*       sinNext = sinN + iHarm * nPar;
+      for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+        cosNext[iPar] = cosPrev[iPar] * cosN[iPar] - sinPrev[iPar] * sinN[iPar];
+        sinNext[iPar] = sinPrev[iPar] * cosN[iPar] + cosPrev[iPar] * sinN[iPar];
+      }
+    }
+  }
+
+  // species bin of a leading hadron: 1 = pion,
+  // 2 = kaon, 3 = proton, 4 = anything else
+  double species(const int32_t pdg) {
+    switch (std::abs(pdg)) {
+      case 211:  return 1.;
+      case 321:  return 2.;
+      case 2212: return 3.;
+      default:   return 4.;
+    }
+  }
+
+  // fill cost of one histogram, summed over threads
+  struct CostRow {
+    std::string name;
+    std::size_t nBins     = 0;
+    double      nFills    = 0.;
+    double      perFill   = -1.;  // mean time per fill in s, < 0 if not timed
+    double      seconds   = 0.;   // estimated time of all fills
+    double      bytes     = 0.;   // memory of all thread-local copies
+    double      occupancy = 0.;   // fraction of bins ever filled
+  };
+
+  // time taken by the timer itself, per timed fill
+  double clockOverhead() {
+    FillCost cost;
+    for (int iTry = 0; iTry < 100000; ++iTry) {
+      const auto start = std::chrono::steady_clock::now();
+      cost.Record(start);
+    }
+    return cost.seconds / cost.nSampled;
+  }
+
+  // collect the cost of histogram iHist of a list
+  // (member) of every thread-local set
+  template <typename Hist> CostRow makeCostRow(
+    const std::vector<HistogramSet>& sets,
+    std::vector<Hist> HistogramSet::* member,
+    const Hist& total,
+    const std::size_t iHist,
+    const double overhead
+  ) {
+    CostRow  row;
+    FillCost cost;
+    row.name  = total.GetName();
+    row.nBins = total.GetSumW().size();
+    for (const auto& set : sets) {
+      const Hist& hist = (set.*member)[iHist];
+      row.nFills    += hist.GetEntries();
+      cost.nSampled += hist.GetCost().nSampled;
+      cost.seconds  += hist.GetCost().seconds;
+    }
+    if (cost.nSampled > 0) {
+      row.perFill = std::max(0., cost.seconds / cost.nSampled - overhead);
+      row.seconds = row.perFill * row.nFills;
+    }
+    row.bytes     = 2. * sizeof(double) * row.nBins * sets.size();
+    row.occupancy = std::count_if(
+      total.GetSumW2().begin(),
+      total.GetSumW2().end(),
+      [](const double sumw2) {return sumw2 > 0.;}
+    ) / static_cast<double>(row.nBins);
+    return row;
+  }
+
+}  // end anonymous namespace
+
 
 
 namespace EPNucleonEnergyCorrelator {
@@ -16,10 +253,25 @@ namespace EPNucleonEnergyCorrelator {
   // --------------------------------------------------------------------------
   //! Initialize class
   // --------------------------------------------------------------------------
-  //! FIXME might not be needed...
+  //! Loads observable plugins, books histograms and
+  //! gives each thread its own copy.
   void Calculator::Init() {
 
-    /* TODO fill in */
+    m_plugins.clear();
+    for (const auto& path : m_opt.plugins) {
+      std::unique_ptr<ObservablePlugin> plugin(new ObservablePlugin());
+      if (!plugin->Load(path)) {
+        std::cerr << "WARNING: skipping plugin '" << path << "'" << std::endl;
+        continue;
+      }
+      m_plugins.push_back(std::move(plugin));
+    }
+
+    Book();
+    m_template.SetCostPeriod(m_opt.costPeriod);
+    m_sets.assign(std::max(1u, m_opt.nThreads), m_template);
+    m_scratch.assign(m_sets.size(), MakeScratch());
+    m_total = m_template;
 
   }  // end 'Init()'
 
@@ -28,22 +280,751 @@ namespace EPNucleonEnergyCorrelator {
   // --------------------------------------------------------------------------
   //! Run calculations
   // --------------------------------------------------------------------------
-  void Calculator::Run() {
+  //! Processes every cluster of the input skim (or
+  //! every batch of the join of a rec and gen skim)
+  //! on a task pool. Returns false if the input
+  //! couldn't be opened or wasn't read in full.
+  bool Calculator::Run() {
+
+    // input is a single skim, or a rec and a gen
+    // skim joined on the event key
+    SkimReader reader(m_opt.read);
+    SkimJoiner join;
+    const bool joined = !m_opt.genFile.empty();
+    if (joined) {
+      if (!join.Open(m_opt.inFile, m_opt.genFile)) return false;
+      std::cout << "    Joining input skims '" << m_opt.inFile << "' and '" << m_opt.genFile << "'" << std::endl;
+    } else {
+      if (!reader.Open(m_opt.inFile)) return false;
+      std::cout << "    Opened input skim (" << reader.NClusters() << " clusters)" << std::endl;
+    }
+
+    // n.b. the readers aren't thread-safe, so batches
+    // are read serially and processed in parallel;
+    // reading stalls while 2 batches per thread are
+    // in flight, so memory doesn't grow with input
+    std::mutex              lock;
+    std::condition_variable drained;
+    std::size_t             inFlight  = 0;
+    const std::size_t       maxFlight = 2 * m_sets.size();
+
+    TaskPool  pool(m_sets.size());
+    TaskPool* outer = m_pool;
+    m_pool = &pool;
+    auto dispatch = [&](std::shared_ptr<EventBatch> batch) {
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        drained.wait(guard, [&]() {return inFlight < maxFlight;});
+        ++inFlight;
+      }
+      pool.Submit([this, batch, &lock, &drained, &inFlight]() {
+        Process(*batch, TaskPool::WorkerIndex());
+        std::lock_guard<std::mutex> guard(lock);
+        --inFlight;
+        drained.notify_one();
+      });
+    };
 
-    /* TODO fill in */
+    // n.b. the joiner stops at the first bad cluster,
+    // while the reader skips it and carries on
+    bool good = true;
+    if (joined) {
+      while (true) {
+        std::shared_ptr<EventBatch> batch(new EventBatch());
+        if (!join.Next(*batch, m_opt.joinBatch)) break;
+        dispatch(batch);
+      }
+      good = !join.Failed();
+    } else {
+      for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+        std::shared_ptr<EventBatch> batch(new EventBatch());
+        if (!reader.Read(iCluster, *batch)) {
+          std::cerr << "WARNING: couldn't read cluster " << iCluster << std::endl;
+          good = false;
+          continue;
+        }
+        dispatch(batch);
+      }
+    }
+    pool.Wait();
+    m_pool = outer;
+
+    if (joined) {
+      std::cout << "    Joined " << join.NJoined() << " events ("
+                << join.NRecOnly() << " only reconstructed, "
+                << join.NGenOnly() << " only generated)" << std::endl;
+    }
+    return good;
 
   }  // end 'Run()'
 
 
+
   // --------------------------------------------------------------------------
   //! Finish computations
   // --------------------------------------------------------------------------
-  //! FIXME might not be needed...
+  //! Merges per-thread histograms, reports their
+  //! fill time and memory (to spot outputs worth
+  //! dropping) and writes them out with the writer
+  //! set by SetWriter().
   void Calculator::End() {
 
-    /* TODO fill in */
+    Reduce();
+    Report();
+    if (!m_writer) {
+      std::cerr << "WARNING: no histogram writer set, '" << m_opt.outFile << "' not written" << std::endl;
+      return;
+    }
+    if (m_writer(m_total, m_opt.outFile)) {
+      std::cout << "    Closed output file" << std::endl;
+    }
 
-  }
+  }  // end 'End()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Process a batch of events on a worker
+  // --------------------------------------------------------------------------
+  //! Per-particle kernels run over the whole batch
+  //! as one stream (see ComputeParticles()), and
+  //! pair correlators are filled per event (see
+  //! FillPairs()). Batches with lab-frame particles
+  //! (already in the head-on frame) also fill lab
+  //! angles, rapidities and the NEC vs. lab
+  //! rapidity. Plugins see the whole batch at once.
+  void Calculator::Process(const EventBatch& batch, const unsigned iWorker) {
+
+    HistogramSet& hists   = m_sets[iWorker];
+    EventScratch& scratch = m_scratch[iWorker];
+
+    // event shapes are needed before the particle
+    // pass, as they can condition it
+    std::vector<EventShapes> recShapes;
+    std::vector<EventShapes> genShapes;
+    ComputeShapes(batch.q2Rec, batch.rec, scratch.shapes, recShapes);
+    ComputeShapes(batch.q2Gen, batch.gen, scratch.shapes, genShapes);
+
+    // per-particle kernels run over each level's
+    // whole batch at once
+    ParticleStream recStream;
+    ParticleStream genStream;
+    ComputeParticles(batch.rec.Stream(), batch.rec.offsets.data(), batch.xbRec.data(), batch.NEvents(), recStream);
+    ComputeParticles(batch.gen.Stream(), batch.gen.offsets.data(), batch.xbGen.data(), batch.NEvents(), genStream);
+
+    FillLevel(batch.q2Rec, batch.xbRec, batch.rec, recShapes, recStream, m_rec, hists);
+    FillLevel(batch.q2Gen, batch.xbGen, batch.gen, genShapes, genStream, m_gen, hists);
+    FillPairs(batch.rec, recShapes, recStream, m_rec, scratch.grid, hists);
+    FillPairs(batch.gen, genShapes, genStream, m_gen, scratch.grid, hists);
+    if (batch.HasRecLab()) FillLab(batch.xbRec, batch.recLab, recShapes, m_rec, hists);
+    if (batch.HasGenLab()) FillLab(batch.xbGen, batch.genLab, genShapes, m_gen, hists);
+
+    for (std::size_t iEvent = 0; iEvent < batch.NEvents(); ++iEvent) {
+      hists.h2[m_xRecVsGen].Fill(batch.xbGen[iEvent], batch.xbRec[iEvent]);
+      hists.h2[m_lnxRecVsGen].Fill(std::log(batch.xbGen[iEvent]), std::log(batch.xbRec[iEvent]));
+      hists.h2[m_qRecVsGen].Fill(batch.q2Gen[iEvent], batch.q2Rec[iEvent]);
+      hists.h2[m_lnqRecVsGen].Fill(std::log(batch.q2Gen[iEvent]), std::log(batch.q2Rec[iEvent]));
+    }
+
+    // energy fractions of reconstructed particles,
+    // i.e. their NEC weights
+    for (const double weight : recStream.weight) {
+      hists.h1[m_weight].Fill(weight);
+    }
+
+    // user observables see the whole batch at once
+    const ObservableSpan span = {batch, 0, batch.NEvents(), recShapes, genShapes};
+    for (auto& plugin : m_plugins) {
+      plugin->Get().Fill(span, hists, iWorker);
+    }
+
+  }  // end 'Process(EventBatch&, unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Process one event of one level
+  // --------------------------------------------------------------------------
+  //! Runs the same kernels as Process() on a view of
+  //! the caller's particles, so nothing is copied,
+  //! and fills the caller's set (e.g. one per
+  //! RDataFrame slot, copied from GetTemplate()).
+  //! Pair loops aren't tiled (events above gridMin
+  //! still go to the grid histogram), and plugins
+  //! and the rec-vs-gen histograms, which need both
+  //! levels of a batch, aren't filled.
+  void Calculator::ProcessEvent(
+    const Level level,
+    const float q2,
+    const float xb,
+    const ParticleView& pars,
+    EventScratch& scratch,
+    HistogramSet& hists
+  ) const {
+
+    const LevelHists& index = (level == Level::Rec) ? m_rec : m_gen;
+
+    // n.b. the event is a stream of one
+    const uint32_t  offsets[2] = {0, static_cast<uint32_t>(pars.size)};
+    ParticleStream& stream     = scratch.particles;
+
+    EventShapes shape;
+    scratch.shapes.Compute(pars, q2, shape);
+    ComputeParticles(pars, offsets, &xb, 1, stream);
+    FillEvent(q2, xb, pars, stream, 0, shape, index, hists);
+
+    PairInputs& in = scratch.pairs;
+    if (!Vetoed(shape)) {
+      pairInputs(pars, offsets, 1, stream, in);
+      if ((pars.size > 1) && (in.sumE[0] > 0.)) {
+        if (UseGrid(pars.size)) {
+          hists.h1[index.eecKernel].Fill(2);
+          scratch.grid.Fill(in.y.data(), in.phi.data(), in.w.data(), pars.size, hists.h1[index.eecXdRGrid]);
+        } else {
+          hists.h1[index.eecKernel].Fill(1);
+          fillPairTile(in, 0, 0, pars.size, 0, pars.size, hists.h1[index.eec], hists.h1[index.eecXdR]);
+        }
+      }
+    }
+
+    // energy fractions of reconstructed particles
+    if (level == Level::Rec) {
+      for (const double weight : stream.weight) {
+        hists.h1[m_weight].Fill(weight);
+      }
+    }
+
+  }  // end 'ProcessEvent(Level, float, float, ParticleView&, EventScratch&, HistogramSet&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Merge per-thread histograms into the total
+  // --------------------------------------------------------------------------
+  //! Bins of every histogram are cut into ranges of
+  //! mergeChunk bins, and each range is summed over
+  //! all threads' sets as one task. Tasks write
+  //! disjoint bins of the total, so no locking is
+  //! needed and the merge scales with the no. of
+  //! threads rather than running on one core.
+  void Calculator::Reduce() {
+
+    if (m_sets.size() == 1) {
+      m_total = m_sets.front();
+      return;
+    }
+    m_total = m_template;
+
+    const auto        start = std::chrono::steady_clock::now();
+    const std::size_t chunk = std::max<std::size_t>(1, m_opt.mergeChunk);
+    {
+      TaskPool pool(m_sets.size());
+      for (std::size_t iHist = 0; iHist < m_total.h1.size(); ++iHist) {
+        const std::size_t nBins = m_total.h1[iHist].GetSumW().size();
+        for (std::size_t first = 0; first < nBins; first += chunk) {
+          const std::size_t last = std::min(first + chunk, nBins);
+          pool.Submit([this, iHist, first, last]() {
+            for (const auto& set : m_sets) {
+              m_total.h1[iHist].MergeBins(set.h1[iHist], first, last);
+            }
+          });
+        }
+      }
+      for (std::size_t iHist = 0; iHist < m_total.h2.size(); ++iHist) {
+        const std::size_t nBins = m_total.h2[iHist].GetSumW().size();
+        for (std::size_t first = 0; first < nBins; first += chunk) {
+          const std::size_t last = std::min(first + chunk, nBins);
+          pool.Submit([this, iHist, first, last]() {
+            for (const auto& set : m_sets) {
+              m_total.h2[iHist].MergeBins(set.h2[iHist], first, last);
+            }
+          });
+        }
+      }
+      pool.Wait();
+    }
+
+    // entries are one number per histogram
+    for (std::size_t iHist = 0; iHist < m_total.h1.size(); ++iHist) {
+      double entries = 0.;
+      for (const auto& set : m_sets) {
+        entries += set.h1[iHist].GetEntries();
+      }
+      m_total.h1[iHist].SetEntries(entries);
+    }
+    for (std::size_t iHist = 0; iHist < m_total.h2.size(); ++iHist) {
+      double entries = 0.;
+      for (const auto& set : m_sets) {
+        entries += set.h2[iHist].GetEntries();
+      }
+      m_total.h2[iHist].SetEntries(entries);
+    }
+
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    std::cout << "    Merged " << m_sets.size() << " thread-local histogram sets in " << took.count() << " s" << std::endl;
+
+  }  // end 'Reduce()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Report the fill cost of each histogram
+  // --------------------------------------------------------------------------
+  //! Fill time is extrapolated from the fills timed
+  //! by each thread (one in costPeriod), less the
+  //! cost of the timer itself, and is CPU time
+  //! summed over threads. n.b. a timed fill can't
+  //! overlap with the code around it, so absolute
+  //! times come out high (~3x for plain 1D/2D fills)
+  //! but the shares are comparable. Memory counts
+  //! every thread's copy. Histograms are listed from most
+  //! to least expensive, with suggestions for ones
+  //! never filled, mostly empty or dominating.
+  void Calculator::Report() const {
+
+    // thresholds for suggestions
+    constexpr double sparseBytes     = 1 << 20;
+    constexpr double sparseOccupancy = 0.1;
+    constexpr double dominantShare   = 0.25;
+
+    const double         overhead = (m_opt.costPeriod > 0) ? clockOverhead() : 0.;
+    std::vector<CostRow> rows;
+    for (std::size_t iHist = 0; iHist < m_total.h1.size(); ++iHist) {
+      rows.push_back(makeCostRow(m_sets, &HistogramSet::h1, m_total.h1[iHist], iHist, overhead));
+    }
+    for (std::size_t iHist = 0; iHist < m_total.h2.size(); ++iHist) {
+      rows.push_back(makeCostRow(m_sets, &HistogramSet::h2, m_total.h2[iHist], iHist, overhead));
+    }
+    std::sort(rows.begin(), rows.end(), [](const CostRow& a, const CostRow& b) {
+      return (a.seconds != b.seconds) ? (a.seconds > b.seconds) : (a.bytes > b.bytes);
+    });
+
+    double seconds = 0.;
+    double bytes   = 0.;
+    for (const auto& row : rows) {
+      seconds += row.seconds;
+      bytes   += row.bytes;
+    }
+
+    if (m_opt.costPeriod > 0) {
+      std::cout << "    Histogram fill cost (1 in " << m_opt.costPeriod << " fills timed, "
+                << overhead * 1e9 << " ns timer overhead subtracted):" << std::endl;
+    } else {
+      std::cout << "    Histogram memory (fill timing off):" << std::endl;
+    }
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "      %-32s %8s %12s %9s %10s %6s %10s %6s  %s",
+                  "histogram", "bins", "fills", "ns/fill", "cpu [s]", "share", "mem [MB]", "used", "suggestion");
+    std::cout << line << std::endl;
+    for (const auto& row : rows) {
+      const double share = (seconds > 0.) ? row.seconds / seconds : 0.;
+
+      std::string note;
+      if (row.nFills == 0.) {
+        note = "never filled, drop?";
+      } else if ((row.bytes >= sparseBytes) && (row.occupancy < sparseOccupancy)) {
+        note = "mostly empty, use sparse storage or coarser bins";
+      }
+      if (share >= dominantShare) {
+        note += note.empty() ? "" : "; ";
+        note += "dominates fill time";
+      }
+
+      if (row.perFill < 0.) {
+        std::snprintf(line, sizeof(line), "      %-32s %8zu %12.0f %9s %10s %6s %10.2f %5.1f%%  %s",
+                      row.name.data(), row.nBins, row.nFills, "-", "-", "-",
+                      row.bytes / (1 << 20), 100. * row.occupancy, note.data());
+      } else {
+        std::snprintf(line, sizeof(line), "      %-32s %8zu %12.0f %9.1f %10.3f %5.1f%% %10.2f %5.1f%%  %s",
+                      row.name.data(), row.nBins, row.nFills, row.perFill * 1e9, row.seconds,
+                      100. * share, row.bytes / (1 << 20), 100. * row.occupancy, note.data());
+      }
+      std::cout << line << std::endl;
+    }
+    std::cout << "    Total: " << seconds << " cpu s filling, " << bytes / (1 << 20) << " MB in "
+              << m_sets.size() << " thread-local sets" << std::endl;
+
+  }  // end 'Report()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Book histograms into the template set
+  // --------------------------------------------------------------------------
+  //! Lab-frame histograms are always booked, and
+  //! only filled for batches with lab particles.
+  void Calculator::Book() {
+
+    m_template = HistogramSet();
+
+    m_rec.x      = m_template.Book(makeHist1D("x", "hXBRec"));
+    m_gen.x      = m_template.Book(makeHist1D("x", "hXBGen"));
+    m_rec.lnx    = m_template.Book(makeHist1D("lnx", "hLogXBRec"));
+    m_gen.lnx    = m_template.Book(makeHist1D("lnx", "hLogXBGen"));
+    m_rec.q      = m_template.Book(makeHist1D("q", "hQ2Rec"));
+    m_gen.q      = m_template.Book(makeHist1D("q", "hQ2Gen"));
+    m_rec.lnq    = m_template.Book(makeHist1D("lnq", "hLogQ2Rec"));
+    m_gen.lnq    = m_template.Book(makeHist1D("lnq", "hLogQ2Gen"));
+    m_rec.th     = m_template.Book(makeHist1D("ang", "hThetaParRec"));
+    m_gen.th     = m_template.Book(makeHist1D("ang", "hThetaParGen"));
+    m_rec.y      = m_template.Book(makeHist1D("rap", "hRapParRec"));
+    m_gen.y      = m_template.Book(makeHist1D("rap", "hRapParGen"));
+    m_rec.e      = m_template.Book(makeHist1D("ene", "hEneParRec"));
+    m_gen.e      = m_template.Book(makeHist1D("ene", "hEneParGen"));
+    m_rec.necXy  = m_template.Book(makeHist1D("rap", "hNECVsRapRec", "#LTNEC#GT"));
+    m_gen.necXy  = m_template.Book(makeHist1D("rap", "hNECVsRapGen", "#LTNEC#GT"));
+    m_rec.necXth = m_template.Book(makeHist1D("ang", "hNECVsThetaRec", "#LTNEC#GT"));
+    m_gen.necXth = m_template.Book(makeHist1D("ang", "hNECVsThetaGen", "#LTNEC#GT"));
+    m_rec.eec    = m_template.Book(makeHist1D("chi", "hEECVsChiRec", "EEC"));
+    m_gen.eec    = m_template.Book(makeHist1D("chi", "hEECVsChiGen", "EEC"));
+    m_rec.eecXdR = m_template.Book(makeHist1D("dR", "hEECVsDeltaRRec", "EEC"));
+    m_gen.eecXdR = m_template.Book(makeHist1D("dR", "hEECVsDeltaRGen", "EEC"));
+    m_rec.tauQ   = m_template.Book(makeHist1D("tauQ", "hTauQRec"));
+    m_gen.tauQ   = m_template.Book(makeHist1D("tauQ", "hTauQGen"));
+    m_rec.tauC   = m_template.Book(makeHist1D("tauC", "hTauCRec"));
+    m_gen.tauC   = m_template.Book(makeHist1D("tauC", "hTauCGen"));
+    m_rec.bQ     = m_template.Book(makeHist1D("bQ", "hBroadQRec"));
+    m_gen.bQ     = m_template.Book(makeHist1D("bQ", "hBroadQGen"));
+    m_rec.rho    = m_template.Book(makeHist1D("rho", "hJetMassRec"));
+    m_gen.rho    = m_template.Book(makeHist1D("rho", "hJetMassGen"));
+    m_rec.gap    = m_template.Book(makeHist1D("gap", "hRapGapRec"));
+    m_gen.gap    = m_template.Book(makeHist1D("gap", "hRapGapGen"));
+    m_rec.leadXE = m_template.Book(makeHist1D("xE", "hLeadXERec"));
+    m_gen.leadXE = m_template.Book(makeHist1D("xE", "hLeadXEGen"));
+
+    m_rec.leadSpecies = m_template.Book(makeHist1D("species", "hLeadSpeciesRec"));
+    m_gen.leadSpecies = m_template.Book(makeHist1D("species", "hLeadSpeciesGen"));
+    m_rec.eecKernel   = m_template.Book(makeHist1D("kernel", "hEECKernelRec", "events"));
+    m_gen.eecKernel   = m_template.Book(makeHist1D("kernel", "hEECKernelGen", "events"));
+    m_rec.eecXdRGrid  = m_template.Book(makeHist1D("dR", "hEECVsDeltaRGridRec", "EEC"));
+    m_gen.eecXdRGrid  = m_template.Book(makeHist1D("dR", "hEECVsDeltaRGridGen", "EEC"));
+    m_weight     = m_template.Book(makeHist1D("weight", "hEneFrac"));
+
+    m_xRecVsGen   = m_template.Book(makeHist2D("x", "x", "hXBRecVsGen"));
+    m_lnxRecVsGen = m_template.Book(makeHist2D("lnx", "lnx", "hLogXBRecVsGen"));
+    m_qRecVsGen   = m_template.Book(makeHist2D("q", "q", "hQ2RecVsGen"));
+    m_lnqRecVsGen = m_template.Book(makeHist2D("lnq", "lnq", "hLogQ2RecVsGen"));
+
+    m_rec.necXyXtauC = m_template.Book(makeHist2D("rap", "tauC", "hNECVsRapVsTauCRec"));
+    m_gen.necXyXtauC = m_template.Book(makeHist2D("rap", "tauC", "hNECVsRapVsTauCGen"));
+    m_rec.necXyXgap  = m_template.Book(makeHist2D("rap", "gap", "hNECVsRapVsGapRec"));
+    m_gen.necXyXgap  = m_template.Book(makeHist2D("rap", "gap", "hNECVsRapVsGapGen"));
+
+    m_rec.leadXEXrank   = m_template.Book(makeHist2D("xE", "rank", "hLeadXEVsRankRec"));
+    m_gen.leadXEXrank   = m_template.Book(makeHist2D("xE", "rank", "hLeadXEVsRankGen"));
+    m_rec.necXyXleadXE  = m_template.Book(makeHist2D("rap", "xE", "hNECVsRapVsLeadXERec"));
+    m_gen.necXyXleadXE  = m_template.Book(makeHist2D("rap", "xE", "hNECVsRapVsLeadXEGen"));
+    m_rec.necXyXspecies = m_template.Book(makeHist2D("rap", "species", "hNECVsRapVsLeadSpeciesRec"));
+    m_gen.necXyXspecies = m_template.Book(makeHist2D("rap", "species", "hNECVsRapVsLeadSpeciesGen"));
+
+    m_rec.cosXy      = m_template.Book(makeHist2D("rap", "harm", "hNECCosNPhiVsRapRec"));
+    m_gen.cosXy      = m_template.Book(makeHist2D("rap", "harm", "hNECCosNPhiVsRapGen"));
+    m_rec.sinXy      = m_template.Book(makeHist2D("rap", "harm", "hNECSinNPhiVsRapRec"));
+    m_gen.sinXy      = m_template.Book(makeHist2D("rap", "harm", "hNECSinNPhiVsRapGen"));
+    m_rec.thLab      = m_template.Book(makeHist1D("angLab", "hThetaParLabRec"));
+    m_gen.thLab      = m_template.Book(makeHist1D("angLab", "hThetaParLabGen"));
+    m_rec.yLab       = m_template.Book(makeHist1D("rapLab", "hRapParLabRec"));
+    m_gen.yLab       = m_template.Book(makeHist1D("rapLab", "hRapParLabGen"));
+    m_rec.necXyLab   = m_template.Book(makeHist1D("rapLab", "hNECVsRapLabRec", "#LTNEC#GT"));
+    m_gen.necXyLab   = m_template.Book(makeHist1D("rapLab", "hNECVsRapLabGen", "#LTNEC#GT"));
+
+    // user observables book after the built-in ones,
+    // so their indices don't shift ours
+    for (auto& plugin : m_plugins) {
+      plugin->Get().Book(m_template, std::max(1u, m_opt.nThreads));
+    }
+
+  }  // end 'Book()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill histograms of one level (rec or gen)
+  // --------------------------------------------------------------------------
+  //! n.b. by definition, the beam is at z = 0 in the
+  //! breit frame. The NEC is also filled in bins of
+  //! tau_C of the event, for events with valid
+  //! shapes, and weighted by cos/sin(n phi) for the
+  //! azimuthal harmonics: dividing those by the NEC
+  //! vs. rapidity gives <cos(n phi)>, <sin(n phi)>
+  //! per rapidity bin. The largest rapidity gap is
+  //! filled for every event, and the NEC in bins of
+  //! it; events with a gap above maxGap (if set)
+  //! are left out of everything else. The NEC is
+  //! conditioned on the x_E and species of the
+  //! leading current hemisphere hadron too, where
+  //! there is one. Per-particle quantities come
+  //! from the level's particle stream.
+  void Calculator::FillLevel(
+    const std::vector<float>& q2,
+    const std::vector<float>& xb,
+    const ParticleColumns& pars,
+    const std::vector<EventShapes>& shapes,
+    const ParticleStream& stream,
+    const LevelHists& index,
+    HistogramSet& hists
+  ) const {
+
+    for (std::size_t iEvent = 0; iEvent < xb.size(); ++iEvent) {
+      FillEvent(q2[iEvent], xb[iEvent], pars.View(iEvent), stream, pars.offsets[iEvent], shapes[iEvent], index, hists);
+    }
+
+  }  // end 'FillLevel(std::vector<float>& x 2, ParticleColumns&, std::vector<EventShapes>&, ParticleStream&, LevelHists&, HistogramSet&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Per-particle kernels of a stream of events
+  // --------------------------------------------------------------------------
+  //! Computes polar angle, rapidity, NEC weight and
+  //! azimuthal harmonics of every particle of the
+  //! stream (event i in [offsets[i], offsets[i +
+  //! 1])) in one pass, across event boundaries, so
+  //! events of a few particles don't each pay for
+  //! a loop of their own. xB^n is broadcast to the
+  //! particles along the offsets.
+  //!   - FIXME weight uses the beam energy from
+  //!     the options
+  void Calculator::ComputeParticles(
+    const ParticleView& pars,
+    const uint32_t* offsets,
+    const float* xb,
+    const std::size_t nEvents,
+    ParticleStream& stream
+  ) const {
+
+    stream.xbPow.resize(nEvents);
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      stream.xbPow[iEvent] = std::pow(xb[iEvent], m_opt.nPow);
+    }
+
+    stream.th.resize(pars.size);
+    stream.y.resize(pars.size);
+    stream.weight.resize(pars.size);
+    Broadcast(offsets, nEvents, stream.xbPow.data(), stream.weight.data());
+    for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+      stream.th[iPar]      = std::atan2(std::hypot(pars.px[iPar], pars.py[iPar]), pars.pz[iPar]);
+      stream.y[iPar]       = std::log(std::tan(stream.th[iPar] / 2.));
+      stream.weight[iPar] *= pars.energy[iPar] / m_opt.pBeam;
+    }
+
+    stream.cosN.resize(NHarmonics * pars.size);
+    stream.sinN.resize(NHarmonics * pars.size);
+    harmonics(pars.px, pars.py, pars.size, stream.cosN.data(), stream.sinN.data());
+
+  }  // end 'ComputeParticles(ParticleView&, uint32_t*, float*, std::size_t, ParticleStream&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill single-particle and event-level histograms of one event
+  // --------------------------------------------------------------------------
+  //! The event's particles are [first, first +
+  //! pars.size) of the stream.
+  void Calculator::FillEvent(
+    const float q2,
+    const float xb,
+    const ParticleView& pars,
+    const ParticleStream& stream,
+    const std::size_t first,
+    const EventShapes& shape,
+    const LevelHists& index,
+    HistogramSet& hists
+  ) const {
+
+    // event-level quantities
+    hists.h1[index.x].Fill(xb);
+    hists.h1[index.lnx].Fill(std::log(xb));
+    hists.h1[index.q].Fill(q2);
+    hists.h1[index.lnq].Fill(std::log(q2));
+
+    // event shapes, and rapidity gap veto
+    hists.h1[index.gap].Fill(shape.gap);
+    if (Vetoed(shape)) return;
+    if (shape.valid) {
+      hists.h1[index.tauQ].Fill(shape.tauQ);
+      hists.h1[index.tauC].Fill(shape.tauC);
+      hists.h1[index.bQ].Fill(shape.bQ);
+      hists.h1[index.rho].Fill(shape.rho);
+    }
+
+    // leading hadrons
+    const LeadingHadron& lead = shape.leading[0];
+    for (std::size_t iLead = 0; iLead < shape.nLeading; ++iLead) {
+      hists.h2[index.leadXEXrank].Fill(shape.leading[iLead].xE, iLead + 1);
+    }
+    if (shape.nLeading > 0) {
+      hists.h1[index.leadXE].Fill(lead.xE);
+      hists.h1[index.leadSpecies].Fill(species(lead.pdg));
+    }
+
+    // particle-level quantities
+    // n.b. harmonic n of the stream's particle i is
+    // at [(n - 1) * stream size + i]
+    const std::size_t nStream = stream.weight.size();
+    for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+      const std::size_t iStream = first + iPar;
+      const double      th      = stream.th[iStream];
+      const double      y       = stream.y[iStream];
+      const double      weight  = stream.weight[iStream];
+      hists.h1[index.th].Fill(th);
+      hists.h1[index.y].Fill(y);
+      hists.h1[index.e].Fill(pars.energy[iPar]);
+      hists.h1[index.necXy].Fill(y, weight);
+      hists.h1[index.necXth].Fill(th, weight);
+      hists.h2[index.necXyXgap].Fill(y, shape.gap, weight);
+      if (shape.nLeading > 0) {
+        hists.h2[index.necXyXleadXE].Fill(y, lead.xE, weight);
+        hists.h2[index.necXyXspecies].Fill(y, species(lead.pdg), weight);
+      }
+      if (shape.valid) {
+        hists.h2[index.necXyXtauC].Fill(y, shape.tauC, weight);
+      }
+
+      // n.b. harmonic n of a rapidity bin is n rows
+      // above its underflow row
+      const std::size_t base   = hists.h2[index.cosXy].FindBin(y, 0.);
+      const std::size_t stride = hists.h2[index.cosXy].GetX().num + 2;
+      for (std::size_t iHarm = 0; iHarm < NHarmonics; ++iHarm) {
+        const std::size_t bin = base + stride * (iHarm + 1);
+        hists.h2[index.cosXy].FillBin(bin, weight * stream.cosN[iHarm * nStream + iStream]);
+        hists.h2[index.sinXy].FillBin(bin, weight * stream.sinN[iHarm * nStream + iStream]);
+      }
+    }
+
+  }  // end 'FillEvent(float, float, ParticleView&, ParticleStream&, std::size_t, EventShapes&, LevelHists&, HistogramSet&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill lab-frame histograms of one level (rec or gen)
+  // --------------------------------------------------------------------------
+  //! Lab-frame particles are already in the head-on
+  //! frame (see Extractor), so z is the hadron beam
+  //! and angles aren't smeared by the crossing
+  //! angle. NEC weights are E_lab / E_p, and events
+  //! vetoed on their (breit-frame) rapidity gap are
+  //! skipped as everywhere else.
+  void Calculator::FillLab(
+    const std::vector<float>& xb,
+    const ParticleColumns& pars,
+    const std::vector<EventShapes>& shapes,
+    const LevelHists& index,
+    HistogramSet& hists
+  ) const {
+
+    ParticleStream stream;
+    ComputeParticles(pars.Stream(), pars.offsets.data(), xb.data(), pars.NEvents(), stream);
+    for (std::size_t iEvent = 0; iEvent < pars.NEvents(); ++iEvent) {
+      if (Vetoed(shapes[iEvent])) continue;
+      for (uint32_t iPar = pars.offsets[iEvent]; iPar < pars.offsets[iEvent + 1]; ++iPar) {
+        hists.h1[index.thLab].Fill(stream.th[iPar]);
+        hists.h1[index.yLab].Fill(stream.y[iPar]);
+        hists.h1[index.necXyLab].Fill(stream.y[iPar], stream.weight[iPar]);
+      }
+    }
+
+  }  // end 'FillLab(std::vector<float>&, ParticleColumns&, std::vector<EventShapes>&, LevelHists&, HistogramSet&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Compute event shapes of one level (rec or gen)
+  // --------------------------------------------------------------------------
+  //! Takes the worker's calculator, so its buffers
+  //! are reused between batches.
+  void Calculator::ComputeShapes(
+    const std::vector<float>& q2,
+    const ParticleColumns& pars,
+    EventShapeCalculator& calculator,
+    std::vector<EventShapes>& shapes
+  ) const {
+
+    shapes.resize(pars.NEvents());
+    for (std::size_t iEvent = 0; iEvent < pars.NEvents(); ++iEvent) {
+      calculator.Compute(pars.View(iEvent), q2[iEvent], shapes[iEvent]);
+    }
+
+  }  // end 'ComputeShapes(std::vector<float>&, ParticleColumns&, EventShapeCalculator&, std::vector<EventShapes>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill pair correlators of one level (rec or gen)
+  // --------------------------------------------------------------------------
+  //! Pairs are weighted by E_i E_j / (sum E)^2, with
+  //! each event's sum E reduced from the batch's
+  //! particle stream, and events vetoed on their
+  //! rapidity gap skipped. Events with more than
+  //! gridMin particles go to the worker's grid
+  //! correlator in one piece, and fill their own
+  //! EEC vs. dR, so the exact EEC vs. chi and dR
+  //! cover the same events. When
+  //! running on the pool, the pair loop of an event
+  //! with more than tileMin particles is cut into
+  //! tileSize x tileSize tiles submitted as nested
+  //! tasks; each tile fills the set of whichever
+  //! worker runs it, so no locking is needed and the
+  //! usual merge in End() sums them up.
+  void Calculator::FillPairs(
+    const ParticleColumns& pars,
+    const std::vector<EventShapes>& shapes,
+    const ParticleStream& stream,
+    const LevelHists& index,
+    GridCorrelator& grid,
+    HistogramSet& hists
+  ) {
+
+    // inputs of the whole batch in one pass
+    // n.b. they live on this frame, so nested calls
+    // while waiting on tiles don't clobber them
+    PairInputs in;
+    pairInputs(pars.Stream(), pars.offsets.data(), pars.NEvents(), stream, in);
+    for (std::size_t iEvent = 0; iEvent < pars.NEvents(); ++iEvent) {
+
+      const ParticleView view  = pars.View(iEvent);
+      const std::size_t  first = pars.offsets[iEvent];
+      if (Vetoed(shapes[iEvent]) || (view.size < 2) || !(in.sumE[iEvent] > 0.)) continue;
+
+      // huge events: approximate on the grid
+      // n.b. nothing waits in here, so nested tasks
+      // can't reuse the grid mid-event
+      if (UseGrid(view.size)) {
+        hists.h1[index.eecKernel].Fill(2);
+        grid.Fill(in.y.data() + first, in.phi.data() + first, in.w.data() + first, view.size, hists.h1[index.eecXdRGrid]);
+        continue;
+      }
+      hists.h1[index.eecKernel].Fill(1);
+
+      // small events (or not on a worker of the
+      // pool): plain loop
+      // n.b. tiles index m_sets by worker, so they
+      // may only run on m_pool, and it must be as
+      // wide as the no. of sets
+      const bool tile = m_pool && (TaskPool::Current() == m_pool) && (m_pool->NWorkers() <= m_sets.size()) && (view.size > m_opt.tileMin);
+      if (!tile) {
+        fillPairTile(in, first, 0, view.size, 0, view.size, hists.h1[index.eec], hists.h1[index.eecXdR]);
+        continue;
+      }
+
+      // giant events: upper-triangle tiles as nested tasks
+      const std::size_t size = std::max<std::size_t>(1, m_opt.tileSize);
+      TaskGroup group(*m_pool);
+      for (std::size_t iBegin = 0; iBegin < view.size; iBegin += size) {
+        for (std::size_t jBegin = iBegin; jBegin < view.size; jBegin += size) {
+          const std::size_t iEnd = std::min(iBegin + size, view.size);
+          const std::size_t jEnd = std::min(jBegin + size, view.size);
+          group.Run([this, &in, &index, first, iBegin, iEnd, jBegin, jEnd]() {
+            HistogramSet& local = m_sets[TaskPool::WorkerIndex()];
+            fillPairTile(in, first, iBegin, iEnd, jBegin, jEnd, local.h1[index.eec], local.h1[index.eecXdR]);
+          });
+        }
+      }
+      group.Wait();
+    }
+
+  }  // end 'FillPairs(ParticleColumns&, std::vector<EventShapes>&, ParticleStream&, LevelHists&, GridCorrelator&, HistogramSet&)'
 
 }  // end EPNucleonEnergyCorrelator namespace
 
@@ -3,42 +3,261 @@
 //! \author Derek Anderson
 //! \date   07.11.2025
 // ----------------------------------------------------------------------------
-//! Calculates NEC and saves them to an RNTuple for
-//! histogramming downstream.
+//! Calculates NEC and saves them to histograms
+//! for analysis downstream.
 // ============================================================================
 
-/* TODO includes go here */
+#ifndef EPNucleonEnergyCorrelator_Calculator_hxx
+#define EPNucleonEnergyCorrelator_Calculator_hxx
+
+// c++ utilities
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+#include "EventShapes.hxx"
+#include "GridCorrelator.hxx"
+#include "Histogram.hxx"
+#include "Observable.hxx"
+#include "Skim.hxx"
+#include "TaskPool.hxx"
 
 
 
 namespace EPNucleonEnergyCorrelator {
 
+  // ==========================================================================
+  //! Calculator options
+  // ==========================================================================
+  struct CalculatorOptions {
+    std::string              inFile     = "epnec.skim";        //!< input skim
+    SkimReaderOptions        read;                             //!< how the input skim is read
+    std::string              genFile    = "";                  //!< if set, gen-level skim joined to inFile on the event key
+    std::size_t              joinBatch  = 4096;                //!< no. of events per joined batch
+    std::string              outFile    = "epnec.hists.root";  //!< output histograms
+    unsigned                 nThreads   = 1;                   //!< no. of threads to use
+    double                   pBeam      = 100.;                //!< proton beam energy (FIXME should come from kinematics)
+    double                   nPow       = 1.0;                 //!< power to raise xb to
+    std::size_t              tileMin    = 1024;                //!< multiplicity above which an event's pair loop is split into tiles
+    std::size_t              tileSize   = 256;                 //!< no. of particles per tile side
+    std::size_t              gridMin    = 4096;                //!< multiplicity above which an event's EEC vs. dR is approximated on a grid (0 = never)
+    double                   gridCellY  = 0.04;                //!< rapidity size of grid cells
+    std::size_t              gridNPhi   = 256;                 //!< no. of grid cells in phi (power of 2)
+    std::size_t              mergeChunk = 16384;               //!< no. of bins per task when merging thread-local histograms
+    EventShapeOptions        shapes;                           //!< options for breit-frame event shapes
+    double                   maxGap     = -1.;                 //!< veto events with a larger rapidity gap from the NECs (< 0 = no veto)
+    std::vector<std::string> plugins;                          //!< observable plugin libraries to load
+    uint32_t                 costPeriod = 4096;                //!< time one in this many fills of each histogram for the cost report (0 = off)
+  };
+
+
+
   // ==========================================================================
   //! NEC Calculator
   // --------------------------------------------------------------------------
   //! Class to process extracted reconstructed and generated
-  //! particles and compute NECs. Computations are stored
-  //! in an RNTuple to be histogrammed downstream.
+  //! particles and compute NECs. Each thread fills its
+  //! own set of histograms, built-in and plugin
+  //! observables alike, which are merged and written
+  //! out at the end. Nothing here depends on ROOT:
+  //! output goes through the writer set with
+  //! SetWriter().
   // ==========================================================================
   class Calculator {
 
     public:
 
+      // level of particles passed to ProcessEvent()
+      enum class Level {Rec, Gen};
+
+      // writes the merged histograms out in End()
+      using Writer = std::function<bool(const HistogramSet&, const std::string&)>;
+
+      // per-particle quantities of a stream of
+      // events, in the order of its particles
+      struct ParticleStream {
+        std::vector<double> xbPow;
+        std::vector<double> th;
+        std::vector<double> y;
+        std::vector<double> weight;
+        std::vector<float>  cosN;
+        std::vector<float>  sinN;
+      };
+
+      // unit vectors, rapidities, azimuths and
+      // energy weights of a stream of events, and
+      // each event's summed energy
+      struct PairInputs {
+        std::vector<float>  nx;
+        std::vector<float>  ny;
+        std::vector<float>  nz;
+        std::vector<float>  y;
+        std::vector<float>  phi;
+        std::vector<float>  w;
+        std::vector<double> sumE;
+        std::vector<double> eventE;
+      };
+
+      // scratch of the per-event kernels, one per thread
+      struct EventScratch {
+        EventShapeCalculator shapes;
+        ParticleStream       particles;
+        PairInputs           pairs;
+        GridCorrelator       grid;
+
+        EventScratch(const EventShapeOptions& opt = EventShapeOptions(), const GridCorrelator& corr = GridCorrelator()) :
+          shapes(opt),
+          grid(corr) {};
+      };
+
       // ctor/dtor
-      Calculator()  {};
+      Calculator(const CalculatorOptions& opt = CalculatorOptions()) : m_opt(opt) {};
       ~Calculator() {};
 
       // interface
       void Init();
-      void Run();
+      bool Run();
       void End();
+      void Process(const EventBatch& batch, const unsigned iWorker);
+
+      // per-event kernels, for callers which hold
+      // their own particles (e.g. RDataFrame columns)
+      // and histogram sets; needs Init() first
+      void         ProcessEvent(const Level level, const float q2, const float xb, const ParticleView& pars, EventScratch& scratch, HistogramSet& hists) const;
+      EventScratch MakeScratch() const {return EventScratch(m_opt.shapes, MakeGrid());}
+
+      // run nested tasks (e.g. pair tiles) on an
+      // external pool; Run() uses its own
+      //   - n.b. without one (e.g. in a Pipeline),
+      //     giant events aren't tiled
+      void SetPool(TaskPool* pool) {m_pool = pool;}
+
+      // set how histograms are written, e.g. to ROOT
+      // files with WriteHistograms()
+      void SetWriter(Writer writer) {m_writer = std::move(writer);}
+
+      // getters
+      const HistogramSet& GetHistograms() const {return m_total;}
+      const HistogramSet& GetTemplate() const {return m_template;}
+      double              GetNEvents() const {return m_total.h1.empty() ? 0. : m_total.h1[m_rec.x].GetEntries();}
+
 
     private:
 
-      /* TODO fill in */
+      // indices of histograms filled per level (rec or gen)
+      struct LevelHists {
+        std::size_t x;
+        std::size_t lnx;
+        std::size_t q;
+        std::size_t lnq;
+        std::size_t th;
+        std::size_t y;
+        std::size_t e;
+        std::size_t necXy;
+        std::size_t necXth;
+        std::size_t eec;
+        std::size_t eecXdR;
+        std::size_t eecXdRGrid;
+        std::size_t eecKernel;
+        std::size_t tauQ;
+        std::size_t tauC;
+        std::size_t bQ;
+        std::size_t rho;
+        std::size_t necXyXtauC;
+        std::size_t gap;
+        std::size_t necXyXgap;
+        std::size_t leadXE;
+        std::size_t leadSpecies;
+        std::size_t leadXEXrank;
+        std::size_t necXyXleadXE;
+        std::size_t necXyXspecies;
+        std::size_t cosXy;
+        std::size_t sinXy;
+        std::size_t thLab;
+        std::size_t yLab;
+        std::size_t necXyLab;
+      };
+
+      // helper methods
+      void Book();
+      void Reduce();
+      void Report() const;
+      void ComputeParticles(
+        const ParticleView& pars,
+        const uint32_t* offsets,
+        const float* xb,
+        const std::size_t nEvents,
+        ParticleStream& stream
+      ) const;
+      void FillLevel(
+        const std::vector<float>& q2,
+        const std::vector<float>& xb,
+        const ParticleColumns& pars,
+        const std::vector<EventShapes>& shapes,
+        const ParticleStream& stream,
+        const LevelHists& index,
+        HistogramSet& hists
+      ) const;
+      void FillEvent(
+        const float q2,
+        const float xb,
+        const ParticleView& pars,
+        const ParticleStream& stream,
+        const std::size_t first,
+        const EventShapes& shape,
+        const LevelHists& index,
+        HistogramSet& hists
+      ) const;
+      void FillLab(
+        const std::vector<float>& xb,
+        const ParticleColumns& pars,
+        const std::vector<EventShapes>& shapes,
+        const LevelHists& index,
+        HistogramSet& hists
+      ) const;
+      void ComputeShapes(
+        const std::vector<float>& q2,
+        const ParticleColumns& pars,
+        EventShapeCalculator& calculator,
+        std::vector<EventShapes>& shapes
+      ) const;
+      void FillPairs(
+        const ParticleColumns& pars,
+        const std::vector<EventShapes>& shapes,
+        const ParticleStream& stream,
+        const LevelHists& index,
+        GridCorrelator& grid,
+        HistogramSet& hists
+      );
+      bool           UseGrid(const std::size_t nPar) const {return (m_opt.gridMin > 0) && (nPar > m_opt.gridMin);}
+      GridCorrelator MakeGrid() const {return GridCorrelator(m_opt.gridCellY, m_opt.gridNPhi);}
+      bool           Vetoed(const EventShapes& shapes) const {return (m_opt.maxGap >= 0.) && (shapes.gap > m_opt.maxGap);}
+
+      // members
+      CalculatorOptions                              m_opt;
+      TaskPool*                                      m_pool = nullptr;
+      Writer                                         m_writer;
+      std::vector<std::unique_ptr<ObservablePlugin>> m_plugins;
+      HistogramSet                                   m_template;
+      std::vector<HistogramSet>                      m_sets;
+      std::vector<EventScratch>                      m_scratch;
+      HistogramSet                                   m_total;
+      LevelHists                                     m_rec;
+      LevelHists                                     m_gen;
+      std::size_t                                    m_weight;
+      std::size_t                                    m_xRecVsGen;
+      std::size_t                                    m_lnxRecVsGen;
+      std::size_t                                    m_qRecVsGen;
+      std::size_t                                    m_lnqRecVsGen;
 
   };  // end Calculator
 
 }  // end EPNucleonEnergyCorrelator namespace
 
+#endif
+
 // end =======================================================================
@@ -0,0 +1,184 @@
+// ============================================================================
+//! \file   Comparison.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Runs several datasets through extraction and
+//! calculation in one job and compares them.
+// ============================================================================
+
+#include "Comparison.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+// package components
+#include "HistogramWriter.hxx"
+#include "TaskPool.hxx"
+
+
+
+namespace {
+
+  using namespace EPNucleonEnergyCorrelator;
+
+  // check two sets hold the same histograms, in the
+  // same order and with the same no. of bins
+  template <typename Hist> bool sameHists(const std::vector<Hist>& lhs, const std::vector<Hist>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (std::size_t iHist = 0; iHist < lhs.size(); ++iHist) {
+      if (lhs[iHist].GetName() != rhs[iHist].GetName()) return false;
+      if (lhs[iHist].GetSumW().size() != rhs[iHist].GetSumW().size()) return false;
+    }
+    return true;
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  Comparison::Comparison(const std::vector<Dataset>& datasets, const ComparisonOptions& opt) :
+    m_datasets(datasets),
+    m_opt(opt)
+  {
+
+    m_opt.nThreads = std::max(1u, m_opt.nThreads);
+
+  }  // end ctor(std::vector<Dataset>&, ComparisonOptions&)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Initialize all datasets
+  // --------------------------------------------------------------------------
+  //! Per-thread state of every dataset is sized to
+  //! the shared pool, and each extractor streams its
+  //! batches to its own calculator.
+  void Comparison::Init() {
+
+    m_extractors.clear();
+    m_calculators.clear();
+    for (auto& dataset : m_datasets) {
+      std::cout << "    Initializing dataset '" << dataset.name << "'" << std::endl;
+      dataset.extract.nThreads = m_opt.nThreads;
+      dataset.calc.nThreads    = m_opt.nThreads;
+
+      m_extractors.emplace_back(new Extractor(dataset.extract));
+      m_calculators.emplace_back(new Calculator(dataset.calc));
+      m_extractors.back()->Init();
+      m_calculators.back()->Init();
+      m_calculators.back()->SetWriter(WriteHistograms);
+
+      Calculator* calculator = m_calculators.back().get();
+      m_extractors.back()->SetSink([calculator](EventBatch& batch, const unsigned iWorker) {
+        calculator->Process(batch, iWorker);
+      });
+    }
+
+  }  // end 'Init()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Run all datasets on one pool
+  // --------------------------------------------------------------------------
+  //! Units are submitted round-robin over datasets so
+  //! all of them progress together.
+  void Comparison::Run() {
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+      TaskPool pool(m_opt.nThreads);
+      for (auto& calculator : m_calculators) {
+        calculator->SetPool(&pool);
+      }
+
+      std::size_t maxUnits = 0;
+      for (const auto& extractor : m_extractors) {
+        maxUnits = std::max(maxUnits, extractor->NUnits());
+      }
+      for (std::size_t iUnit = 0; iUnit < maxUnits; ++iUnit) {
+        for (auto& extractor : m_extractors) {
+          if (iUnit >= extractor->NUnits()) continue;
+
+          Extractor* ext = extractor.get();
+          pool.Submit([ext, iUnit]() {
+            ext->Extract(iUnit, TaskPool::WorkerIndex());
+          });
+        }
+      }
+      pool.Wait();
+
+      for (auto& calculator : m_calculators) {
+        calculator->SetPool(nullptr);
+      }
+    }
+
+    // partial batches go to the calculators too
+    for (auto& extractor : m_extractors) {
+      extractor->Flush();
+      extractor->SetSink(nullptr);
+    }
+
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    std::cout << "    Ran " << m_datasets.size() << " datasets in " << took.count() << " s" << std::endl;
+
+  }  // end 'Run()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write per-dataset outputs and ratios
+  // --------------------------------------------------------------------------
+  //! Ratios are dataset / reference, with the first
+  //! dataset as reference; with perEvent set both are
+  //! normalized to their no. of events first.
+  //! Datasets whose histograms don't match the
+  //! reference's (e.g. other plugins) are skipped.
+  void Comparison::End() {
+
+    for (std::size_t iSet = 0; iSet < m_datasets.size(); ++iSet) {
+      std::cout << "    Dataset '" << m_datasets[iSet].name << "' cut flow:\n";
+      m_extractors[iSet]->GetCutFlow().Print(std::cout);
+      m_calculators[iSet]->End();
+    }
+    if (m_datasets.size() < 2) return;
+
+    const HistogramSet& ref  = m_calculators[0]->GetHistograms();
+    const double        nRef = m_calculators[0]->GetNEvents();
+
+    HistogramSet ratios;
+    for (std::size_t iSet = 1; iSet < m_datasets.size(); ++iSet) {
+      const HistogramSet& hists = m_calculators[iSet]->GetHistograms();
+      if (!sameHists(hists.h1, ref.h1) || !sameHists(hists.h2, ref.h2)) {
+        std::cerr << "WARNING: histograms of dataset '" << m_datasets[iSet].name << "' don't match those of '"
+                  << m_datasets[0].name << "', no ratios for it" << std::endl;
+        continue;
+      }
+
+      const double      nEvt   = m_calculators[iSet]->GetNEvents();
+      const double      scale  = (m_opt.perEvent && (nEvt > 0.)) ? nRef / nEvt : 1.;
+      const std::string suffix = "_" + m_datasets[iSet].name + "Over" + m_datasets[0].name;
+      for (std::size_t iHist = 0; iHist < hists.h1.size(); ++iHist) {
+        ratios.Book(Divide(hists.h1[iHist], ref.h1[iHist], hists.h1[iHist].GetName() + suffix, scale));
+      }
+      for (std::size_t iHist = 0; iHist < hists.h2.size(); ++iHist) {
+        ratios.Book(Divide(hists.h2[iHist], ref.h2[iHist], hists.h2[iHist].GetName() + suffix, scale));
+      }
+    }
+
+    if (WriteHistograms(ratios, m_opt.outFile)) {
+      std::cout << "    Wrote ratios to '" << m_opt.outFile << "'" << std::endl;
+    }
+
+  }  // end 'End()'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,86 @@
+// ============================================================================
+//! \file   Comparison.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Runs several datasets through extraction and
+//! calculation in one job and compares them.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Comparison_hxx
+#define EPNucleonEnergyCorrelator_Comparison_hxx
+
+// c++ utilities
+#include <memory>
+#include <string>
+#include <vector>
+// package components
+#include "Calculator.hxx"
+#include "Extractor.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! A dataset to compare
+  // ==========================================================================
+  struct Dataset {
+    std::string       name;     //!< label, used in output names
+    ExtractorOptions  extract;  //!< inputs and selection
+    CalculatorOptions calc;     //!< calculation and per-dataset output
+  };
+
+
+
+  // ==========================================================================
+  //! Comparison options
+  // ==========================================================================
+  struct ComparisonOptions {
+    unsigned    nThreads = 1;                     //!< no. of threads shared by all datasets
+    std::string outFile  = "epnec.compare.root";  //!< output ratio histograms
+    bool        perEvent = true;                  //!< normalize each dataset per event before dividing
+  };
+
+
+
+  // ==========================================================================
+  //! Multi-dataset comparison
+  // --------------------------------------------------------------------------
+  //! Every dataset gets its own Extractor and
+  //! Calculator, but their work units are interleaved
+  //! on one work-stealing pool and streamed straight
+  //! into the calculators, so a small dataset doesn't
+  //! leave threads idle while a big one runs. At
+  //! End() each dataset writes its own histograms
+  //! and the ratio of every histogram to the first
+  //! (reference) dataset is written out.
+  // ==========================================================================
+  class Comparison {
+
+    public:
+
+      // ctor/dtor
+      Comparison(const std::vector<Dataset>& datasets, const ComparisonOptions& opt = ComparisonOptions());
+      ~Comparison() {};
+
+      // interface
+      void Init();
+      void Run();
+      void End();
+
+    private:
+
+      // members
+      std::vector<Dataset>                     m_datasets;
+      ComparisonOptions                        m_opt;
+      std::vector<std::unique_ptr<Extractor>>  m_extractors;
+      std::vector<std::unique_ptr<Calculator>> m_calculators;
+
+  };  // end Comparison
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
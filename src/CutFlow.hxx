@@ -0,0 +1,85 @@
+// ============================================================================
+//! \file   CutFlow.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Simple named counters to track how many events
+//! or particles each selection step removes.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_CutFlow_hxx
+#define EPNucleonEnergyCorrelator_CutFlow_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Cut flow
+  // --------------------------------------------------------------------------
+  //! Steps are booked once and then incremented by
+  //! index, so counting in the event loop doesn't
+  //! involve any string lookups. Not thread-safe:
+  //! keep one per thread and Merge() at the end.
+  // ==========================================================================
+  class CutFlow {
+
+    public:
+
+      // ctor/dtor
+      CutFlow()  {};
+      ~CutFlow() {};
+
+      // book a step, returns its index
+      std::size_t Book(const std::string& step) {
+        for (std::size_t iStep = 0; iStep < m_steps.size(); ++iStep) {
+          if (m_steps[iStep] == step) return iStep;
+        }
+        m_steps.push_back(step);
+        m_counts.push_back(0);
+        return m_steps.size() - 1;
+      }
+
+      // increment a step
+      void Count(const std::size_t iStep, const uint64_t n = 1) {
+        m_counts[iStep] += n;
+      }
+
+      // add counts of another cut flow
+      void Merge(const CutFlow& other) {
+        for (std::size_t iStep = 0; iStep < other.m_steps.size(); ++iStep) {
+          m_counts[Book(other.m_steps[iStep])] += other.m_counts[iStep];
+        }
+      }
+
+      // print all steps
+      void Print(std::ostream& out) const {
+        for (std::size_t iStep = 0; iStep < m_steps.size(); ++iStep) {
+          out << "      " << m_steps[iStep] << ": " << m_counts[iStep] << "\n";
+        }
+      }
+
+      // getters
+      uint64_t           GetCount(const std::size_t iStep) const {return m_counts[iStep];}
+      const std::string& GetStep(const std::size_t iStep) const {return m_steps[iStep];}
+      std::size_t        Size() const {return m_steps.size();}
+
+    private:
+
+      // members
+      std::vector<std::string> m_steps;
+      std::vector<uint64_t>    m_counts;
+
+  };  // end CutFlow
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
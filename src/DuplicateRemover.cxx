@@ -0,0 +1,227 @@
+// ============================================================================
+//! \file   DuplicateRemover.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Finds particles reconstructed in both the central
+//! and far-forward collections using a hash on
+//! quantized (theta, phi, energy).
+// ============================================================================
+
+#include "DuplicateRemover.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+
+namespace {
+
+  constexpr float    Pi       = 3.14159265358979f;
+  constexpr uint64_t EmptyKey = std::numeric_limits<uint64_t>::max();
+
+  // splitmix64 finalizer, spreads neighbouring cells over the table
+  inline uint64_t mix(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  DuplicateRemover::DuplicateRemover(const DuplicateOptions& opt) : m_opt(opt) {
+
+    m_lnETol = std::log1p(m_opt.relETol);
+    m_nPhi   = std::max(1, static_cast<int32_t>(2.f * Pi / m_opt.phiTol));
+
+  }  // end ctor(DuplicateOptions&)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Find and resolve duplicates in an event
+  // --------------------------------------------------------------------------
+  //! Each far-forward particle is paired with the
+  //! closest central particle within tolerance (each
+  //! central particle is used at most once), then the
+  //! policy decides which one survives. Returns the
+  //! no. of pairs found.
+  std::size_t DuplicateRemover::Resolve(
+    const ParticleView& central,
+    const ParticleView& forward,
+    std::vector<char>& keepCentral,
+    std::vector<char>& keepForward
+  ) {
+
+    keepCentral.assign(central.size, 1);
+    keepForward.assign(forward.size, 1);
+    if ((central.size == 0) || (forward.size == 0)) return 0;
+
+    // hash central particles: open addressing on the
+    // cell key, particles in the same cell are chained
+    std::size_t capacity = 16;
+    while (capacity < 2 * central.size) capacity <<= 1;
+    m_tableKey.assign(capacity, EmptyKey);
+    m_tableHead.assign(capacity, -1);
+    m_next.assign(central.size, -1);
+    m_theta.resize(central.size);
+    m_phi.resize(central.size);
+    m_lnE.resize(central.size);
+
+    for (std::size_t iCen = 0; iCen < central.size; ++iCen) {
+      const Cell cell = Quantize(central, iCen, m_theta[iCen], m_phi[iCen], m_lnE[iCen]);
+      if (!cell.valid) continue;
+
+      const uint64_t key  = Key(cell.theta, cell.phi, cell.ene);
+      std::size_t    slot = mix(key) & (capacity - 1);
+      while ((m_tableKey[slot] != EmptyKey) && (m_tableKey[slot] != key)) {
+        slot = (slot + 1) & (capacity - 1);
+      }
+      m_tableKey[slot]  = key;
+      m_next[iCen]      = m_tableHead[slot];
+      m_tableHead[slot] = iCen;
+    }
+
+    // look for a partner of each far-forward particle
+    std::size_t nPairs = 0;
+    for (std::size_t iFor = 0; iFor < forward.size; ++iFor) {
+
+      float      theta = 0.;
+      float      phi   = 0.;
+      float      lnE   = 0.;
+      const Cell cell  = Quantize(forward, iFor, theta, phi, lnE);
+      if (!cell.valid) continue;
+
+      int32_t best     = -1;
+      float   bestDist = std::numeric_limits<float>::max();
+      for (int32_t dTh = -1; dTh <= 1; ++dTh) {
+        for (int32_t dPh = -1; dPh <= 1; ++dPh) {
+          for (int32_t dE = -1; dE <= 1; ++dE) {
+
+            const int32_t iPhi = (cell.phi + dPh + m_nPhi) % m_nPhi;
+            for (int32_t iCen = Head(Key(cell.theta + dTh, iPhi, cell.ene + dE)); iCen >= 0; iCen = m_next[iCen]) {
+              if (keepCentral[iCen] != 1) continue;
+
+              const float dTheta = std::fabs(theta - m_theta[iCen]) / m_opt.thetaTol;
+              float       dPhi   = std::fabs(phi - m_phi[iCen]);
+              if (dPhi > Pi) dPhi = 2.f * Pi - dPhi;
+              dPhi /= m_opt.phiTol;
+              const float dLnE = std::fabs(lnE - m_lnE[iCen]) / m_lnETol;
+              if ((dTheta > 1.f) || (dPhi > 1.f) || (dLnE > 1.f)) continue;
+
+              const float dist = (dTheta * dTheta) + (dPhi * dPhi) + (dLnE * dLnE);
+              if (dist < bestDist) {
+                bestDist = dist;
+                best     = iCen;
+              }
+            }
+          }
+        }
+      }
+      if (best < 0) continue;
+
+      // resolve pair
+      bool dropForward = true;
+      switch (m_opt.policy) {
+        case DuplicatePolicy::KeepCentral:
+          dropForward = true;
+          break;
+        case DuplicatePolicy::KeepFarForward:
+          dropForward = false;
+          break;
+        case DuplicatePolicy::KeepHigherEnergy:
+          dropForward = (forward.energy[iFor] <= central.energy[best]);
+          break;
+      }
+      if (dropForward) {
+        keepForward[iFor] = 0;
+      }
+      keepCentral[best] = dropForward ? 2 : 0;  // n.b. 2 = kept but already paired
+      ++nPairs;
+    }
+
+    // unmark paired-but-kept central particles
+    for (auto& keep : keepCentral) {
+      keep = (keep != 0);
+    }
+    return nPairs;
+
+  }  // end 'Resolve(ParticleView&, ParticleView&, std::vector<char>&, std::vector<char>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Quantize a particle's (theta, phi, ln E)
+  // --------------------------------------------------------------------------
+  DuplicateRemover::Cell DuplicateRemover::Quantize(
+    const ParticleView& pars,
+    const std::size_t iPar,
+    float& theta,
+    float& phi,
+    float& lnE
+  ) const {
+
+    const float ene = pars.energy[iPar];
+    if (!(ene > 0.f)) {
+      return {0, 0, 0, false};
+    }
+
+    theta = std::atan2(std::hypot(pars.px[iPar], pars.py[iPar]), pars.pz[iPar]);
+    phi   = std::atan2(pars.py[iPar], pars.px[iPar]);
+    lnE   = std::log(ene);
+
+    Cell cell;
+    cell.theta = static_cast<int32_t>(std::floor(theta / m_opt.thetaTol));
+    cell.phi   = static_cast<int32_t>(std::floor((phi + Pi) / (2.f * Pi) * m_nPhi)) % m_nPhi;
+    cell.ene   = static_cast<int32_t>(std::floor(lnE / m_lnETol));
+    cell.valid = true;
+    return cell;
+
+  }  // end 'Quantize(ParticleView&, std::size_t, float&, float&, float&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Pack cell indices into a key
+  // --------------------------------------------------------------------------
+  //! n.b. 21 bits per coordinate, the energy index
+  //! is offset to be positive.
+  uint64_t DuplicateRemover::Key(const int32_t theta, const int32_t phi, const int32_t ene) const {
+
+    const uint64_t mask = (1ULL << 21) - 1;
+    return ((static_cast<uint64_t>(theta) & mask) << 42)
+         | ((static_cast<uint64_t>(phi) & mask) << 21)
+         | (static_cast<uint64_t>(ene + (1 << 20)) & mask);
+
+  }  // end 'Key(int32_t, int32_t, int32_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get first central particle in a cell, -1 if empty
+  // --------------------------------------------------------------------------
+  int32_t DuplicateRemover::Head(const uint64_t key) const {
+
+    const std::size_t capacity = m_tableKey.size();
+    for (std::size_t slot = mix(key) & (capacity - 1); m_tableKey[slot] != EmptyKey; slot = (slot + 1) & (capacity - 1)) {
+      if (m_tableKey[slot] == key) return m_tableHead[slot];
+    }
+    return -1;
+
+  }  // end 'Head(uint64_t)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
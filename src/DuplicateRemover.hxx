@@ -0,0 +1,108 @@
+// ============================================================================
+//! \file   DuplicateRemover.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Finds particles reconstructed in both the central
+//! and far-forward collections using a hash on
+//! quantized (theta, phi, energy).
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_DuplicateRemover_hxx
+#define EPNucleonEnergyCorrelator_DuplicateRemover_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Which particle of a duplicate pair is kept
+  // ==========================================================================
+  enum class DuplicatePolicy {
+    KeepCentral,      //!< drop the far-forward particle
+    KeepFarForward,   //!< drop the central particle
+    KeepHigherEnergy  //!< drop the lower energy particle
+  };
+
+
+
+  // ==========================================================================
+  //! Duplicate remover options
+  // ==========================================================================
+  struct DuplicateOptions {
+    float           thetaTol = 0.002;                        //!< max |dtheta| of a duplicate pair [rad]
+    float           phiTol   = 0.01;                         //!< max |dphi| of a duplicate pair [rad]
+    float           relETol  = 0.1;                          //!< max |E1 - E2| / min(E1, E2) of a duplicate pair
+    DuplicatePolicy policy   = DuplicatePolicy::KeepCentral;  //!< how pairs are resolved
+  };
+
+
+
+  // ==========================================================================
+  //! Central/far-forward duplicate remover
+  // --------------------------------------------------------------------------
+  //! Central particles are hashed on (theta, phi,
+  //! ln E) quantized with the tolerances as cell
+  //! sizes, so every duplicate of a far-forward
+  //! particle is in one of the 27 neighbouring
+  //! cells. Cost per event is O(N_central +
+  //! N_forward). Buffers are reused between events,
+  //! so one remover should be kept per thread.
+  // ==========================================================================
+  class DuplicateRemover {
+
+    public:
+
+      // ctor/dtor
+      DuplicateRemover(const DuplicateOptions& opt = DuplicateOptions());
+      ~DuplicateRemover() {};
+
+      // interface
+      std::size_t Resolve(
+        const ParticleView& central,
+        const ParticleView& forward,
+        std::vector<char>& keepCentral,
+        std::vector<char>& keepForward
+      );
+
+    private:
+
+      // quantized coordinates of a particle
+      struct Cell {
+        int32_t theta;
+        int32_t phi;
+        int32_t ene;
+        bool    valid;
+      };
+
+      // helper methods
+      Cell     Quantize(const ParticleView& pars, const std::size_t iPar, float& theta, float& phi, float& lnE) const;
+      uint64_t Key(const int32_t theta, const int32_t phi, const int32_t ene) const;
+      int32_t  Head(const uint64_t key) const;
+
+      // members
+      DuplicateOptions m_opt;
+      float            m_lnETol;
+      int32_t          m_nPhi;
+
+      // per-event buffers
+      std::vector<float>    m_theta;
+      std::vector<float>    m_phi;
+      std::vector<float>    m_lnE;
+      std::vector<uint64_t> m_tableKey;
+      std::vector<int32_t>  m_tableHead;
+      std::vector<int32_t>  m_next;
+
+  };  // end DuplicateRemover
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
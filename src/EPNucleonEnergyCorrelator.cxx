@@ -4,17 +4,274 @@
 //! \date   07.11.2025
 // ----------------------------------------------------------------------------
 //! Main executable for package.
+//!
+//! Usage: epnec [options] <input files>
+//!   --out <file>       output skim
+//!   --hists <file>     output histograms; with
+//!                      --dataset, a prefix for the
+//!                      per-dataset and ratio files
+//!   --catalog <file>   file metadata catalog
+//!   --threads <n>      no. of threads
+//!   --format <fmt>     input format: eicrecon
+//!                      (default), hepmc3 (ASCII) or
+//!                      hepmc3-root
+//!   --io-only          only read the needed branches
+//!                      and report throughput
+//!   --stream           extract and calculate in one
+//!                      pass, without writing a skim
+//!                      (giant events aren't tiled)
+//!   --calc <skim>      only calculate, from a skim
+//!   --uring            with --calc, read the skim
+//!                      through io_uring (linux)
+//!   --gen <skim>       with --calc, take generated
+//!                      events from this skim, joined
+//!                      on the (run, event) key
+//!   --plugin <lib>     load an observable plugin;
+//!                      repeat to load several
+//!   --max-gap <dy>     veto events with a larger
+//!                      rapidity gap from the NECs
+//!   --grid-min <n>     approximate the EEC vs. dR of
+//!                      events with more than n
+//!                      particles on a grid, into
+//!                      hEECVsDeltaRGrid* (default
+//!                      4096, 0 = never)
+//!   --lab              also extract lab-frame particles
+//!                      (ReconstructedParticles,
+//!                      GeneratedParticles), moved to
+//!                      the head-on frame of the beams
+//!   --no-head-on       with --lab, keep raw lab
+//!                      momenta (no crossing angle
+//!                      correction)
+//!   --fill-cost <n>    time one in n histogram fills
+//!                      for the cost report (default
+//!                      4096, 0 = off)
+//!   --log <file>       diagnostics log (default
+//!                      stderr)
+//!   --dataset <name>=<list>
+//!                      add a dataset to compare, with
+//!                      input files listed one per
+//!                      line; repeat to compare several
 // ============================================================================
 
+// c++ utilities
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+// package components
 #include "Calculator.hxx"
+#include "Comparison.hxx"
 #include "Extractor.hxx"
-/* TODO more go here */
+#include "HistogramWriter.hxx"
+#include "Logger.hxx"
+#include "Pipeline.hxx"
+
+using namespace EPNucleonEnergyCorrelator;
+
+
+
+// ----------------------------------------------------------------------------
+//! Read a list of files, one per line
+// ----------------------------------------------------------------------------
+//! Blank lines and lines starting with '#' are
+//! skipped.
+bool ReadFileList(const std::string& path, std::vector<std::string>& files) {
+
+  std::ifstream list(path);
+  if (!list) {
+    std::cerr << "PANIC: couldn't open file list '" << path << "'!" << std::endl;
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(list, line)) {
+    if (line.empty() || (line[0] == '#')) continue;
+    files.push_back(line);
+  }
+  return true;
+
+}  // end 'ReadFileList(std::string&, std::vector<std::string>&)'
+
 
 
 int main(int argc, char* argv[]) {
 
-  /* TODO fill in */
+  // parse arguments
+  ExtractorOptions         opt;
+  CalculatorOptions        calc;
+  bool                     ioOnly   = false;
+  bool                     stream   = false;
+  bool                     calcOnly = false;
+  std::string              log      = "";
+  std::string              hists    = "";
+  std::vector<std::string> datasets;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    const std::string arg = argv[iArg];
+    const bool        more = (iArg + 1 < argc);
+    if (arg == "--io-only") {
+      ioOnly = true;
+    } else if (arg == "--stream") {
+      stream = true;
+    } else if (arg == "--uring") {
+      calc.read.backend = ReadBackend::Uring;
+    } else if ((arg == "--calc") && more) {
+      calcOnly    = true;
+      calc.inFile = argv[++iArg];
+    } else if ((arg == "--dataset") && more) {
+      datasets.push_back(argv[++iArg]);
+    } else if ((arg == "--plugin") && more) {
+      calc.plugins.push_back(argv[++iArg]);
+    } else if ((arg == "--max-gap") && more) {
+      calc.maxGap = std::atof(argv[++iArg]);
+    } else if ((arg == "--grid-min") && more) {
+      calc.gridMin = std::strtoul(argv[++iArg], nullptr, 10);
+    } else if (arg == "--lab") {
+      opt.recParsLab = "ReconstructedParticles";
+      opt.genParsLab = "GeneratedParticles";
+    } else if (arg == "--no-head-on") {
+      opt.headOn = false;
+    } else if ((arg == "--fill-cost") && more) {
+      calc.costPeriod = std::strtoul(argv[++iArg], nullptr, 10);
+    } else if ((arg == "--log") && more) {
+      log = argv[++iArg];
+    } else if ((arg == "--gen") && more) {
+      calc.genFile = argv[++iArg];
+    } else if ((arg == "--out") && more) {
+      opt.outFile = argv[++iArg];
+    } else if ((arg == "--hists") && more) {
+      hists        = argv[++iArg];
+      calc.outFile = hists;
+    } else if ((arg == "--catalog") && more) {
+      opt.catalog = argv[++iArg];
+    } else if ((arg == "--format") && more) {
+      const std::string format = argv[++iArg];
+      if (format == "eicrecon") {
+        opt.format = InputFormat::EICrecon;
+      } else if (format == "hepmc3") {
+        opt.format = InputFormat::HepMC3Ascii;
+      } else if (format == "hepmc3-root") {
+        opt.format = InputFormat::HepMC3Root;
+      } else {
+        std::cerr << "PANIC: unknown input format '" << format << "'!" << std::endl;
+        return 1;
+      }
+    } else if ((arg == "--threads") && more) {
+      const char*         value    = argv[++iArg];
+      char*               end      = nullptr;
+      const unsigned long nThreads = std::strtoul(value, &end, 10);
+      if ((value[0] == '-') || (end == value) || (*end != '\0') || (nThreads == 0) || (nThreads > 4096)) {
+        std::cerr << "PANIC: no. of threads should be between 1 and 4096, got '" << value << "'!" << std::endl;
+        return 1;
+      }
+      opt.nThreads  = nThreads;
+      calc.nThreads = opt.nThreads;
+    } else if (arg.rfind("--", 0) == 0) {
+      std::cerr << "PANIC: unknown option '" << arg << "'!" << std::endl;
+      return 1;
+    } else {
+      opt.inFiles.push_back(arg);
+    }
+  }
+
+  // diagnostics from worker threads go through
+  // the asynchronous logger
+  Logger::Get().Start(log);
+
+  // compare several datasets
+  if (!datasets.empty()) {
+
+    // n.b. --hists names the files of each dataset
+    // as <prefix>.<name>.root
+    std::string prefix = "";
+    if (!hists.empty()) {
+      const std::size_t ext = hists.rfind(".root");
+      prefix = ((ext != std::string::npos) && (ext + 5 == hists.size())) ? hists.substr(0, ext) + "." : hists + ".";
+    }
+
+    std::vector<Dataset> sets;
+    for (const auto& definition : datasets) {
+      const std::size_t split = definition.find('=');
+      if (split == std::string::npos) {
+        std::cerr << "PANIC: dataset '" << definition << "' should be <name>=<list>!" << std::endl;
+        return 1;
+      }
+
+      Dataset set;
+      set.name         = definition.substr(0, split);
+      set.extract      = opt;
+      set.calc         = calc;
+      set.calc.outFile = prefix.empty() ? (set.name + ".hists.root") : (prefix + set.name + ".root");
+      set.extract.inFiles.clear();
+      if (!ReadFileList(definition.substr(split + 1), set.extract.inFiles)) {
+        return 1;
+      }
+      sets.push_back(set);
+    }
+
+    std::cout << "\n  Starting NEC comparison!" << std::endl;
+    ComparisonOptions compare;
+    compare.nThreads = opt.nThreads;
+    if (!prefix.empty()) {
+      compare.outFile = prefix + "compare.root";
+    }
+
+    Comparison comparison(sets, compare);
+    comparison.Init();
+    comparison.Run();
+    comparison.End();
+    Logger::Get().Stop();
+    std::cout << "  NEC comparison finished!\n" << std::endl;
+    return 0;
+  }
+
+  // calculate from an existing skim
+  if (calcOnly) {
+    std::cout << "\n  Starting NEC calculation!" << std::endl;
+    Calculator calculator(calc);
+    calculator.SetWriter(WriteHistograms);
+    calculator.Init();
+    if (!calculator.Run()) {
+      std::cerr << "PANIC: couldn't read input skims in full, no histograms written!" << std::endl;
+      Logger::Get().Stop();
+      return 1;
+    }
+    calculator.End();
+    Logger::Get().Stop();
+    std::cout << "  NEC calculation finished!\n" << std::endl;
+    return 0;
+  }
+
+  if (opt.inFiles.empty()) {
+    std::cerr << "PANIC: no input files!" << std::endl;
+    return 1;
+  }
+
+  // run extraction
+  std::cout << "\n  Starting NEC extraction!" << std::endl;
+
+  Extractor extractor(opt);
+  extractor.Init();
+  if (ioOnly) {
+    extractor.RunIOOnly();
+  } else if (stream) {
+    PipelineOptions pipe;
+    pipe.nThreads = opt.nThreads;
+
+    Calculator calculator(calc);
+    calculator.SetWriter(WriteHistograms);
+    calculator.Init();
+    Pipeline(extractor, calculator, pipe).Run();
+    std::cout << "    Cut flow:\n";
+    extractor.GetCutFlow().Print(std::cout);
+    calculator.End();
+  } else {
+    extractor.Run();
+    extractor.End();
+  }
+  Logger::Get().Stop();
 
+  std::cout << "  NEC extraction finished!\n" << std::endl;
   return 0;
 
 }
@@ -0,0 +1,236 @@
+// ============================================================================
+//! \file   EventBatch.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Structure-of-arrays data model for batches of
+//! extracted events and their particles.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_EventBatch_hxx
+#define EPNucleonEnergyCorrelator_EventBatch_hxx
+
+// c++ utilities
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Read-only view of one event's particles
+  // --------------------------------------------------------------------------
+  //! Points into the columns of a ParticleColumns
+  //! object, so it's only valid as long as that
+  //! object isn't modified.
+  // ==========================================================================
+  struct ParticleView {
+    const float*   energy = nullptr;  //!< energies
+    const float*   px     = nullptr;  //!< x momenta
+    const float*   py     = nullptr;  //!< y momenta
+    const float*   pz     = nullptr;  //!< z momenta
+    const int32_t* pdg    = nullptr;  //!< pdg codes
+    std::size_t    size   = 0;        //!< no. of particles
+  };
+
+
+
+  // ==========================================================================
+  //! Particle columns
+  // --------------------------------------------------------------------------
+  //! Particles of several events stored column-wise.
+  //! Particles of event i are in [offsets[i],
+  //! offsets[i + 1]).
+  // ==========================================================================
+  struct ParticleColumns {
+    std::vector<float>    energy;        //!< energies
+    std::vector<float>    px;            //!< x momenta
+    std::vector<float>    py;            //!< y momenta
+    std::vector<float>    pz;            //!< z momenta
+    std::vector<int32_t>  pdg;           //!< pdg codes
+    std::vector<uint32_t> offsets {0};   //!< first particle of each event, plus total
+
+    std::size_t NEvents() const {return offsets.size() - 1;}
+    std::size_t Size() const {return energy.size();}
+
+    void Add(const float e, const float x, const float y, const float z, const int32_t id) {
+      energy.push_back(e);
+      px.push_back(x);
+      py.push_back(y);
+      pz.push_back(z);
+      pdg.push_back(id);
+    }
+
+    void EndEvent() {
+      offsets.push_back(energy.size());
+    }
+
+    void AddEvent(const ParticleView& view) {
+      energy.insert(energy.end(), view.energy, view.energy + view.size);
+      px.insert(px.end(), view.px, view.px + view.size);
+      py.insert(py.end(), view.py, view.py + view.size);
+      pz.insert(pz.end(), view.pz, view.pz + view.size);
+      pdg.insert(pdg.end(), view.pdg, view.pdg + view.size);
+      EndEvent();
+    }
+
+    void Clear() {
+      energy.clear();
+      px.clear();
+      py.clear();
+      pz.clear();
+      pdg.clear();
+      offsets.assign(1, 0);
+    }
+
+    ParticleView View(const std::size_t iEvent) const {
+      const std::size_t first = offsets[iEvent];
+      return {
+        energy.data() + first,
+        px.data() + first,
+        py.data() + first,
+        pz.data() + first,
+        pdg.data() + first,
+        offsets[iEvent + 1] - first
+      };
+    }
+
+    // view of every particle of every event, as one
+    // flat stream
+    ParticleView Stream() const {
+      return {energy.data(), px.data(), py.data(), pz.data(), pdg.data(), energy.size()};
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! Broadcast per-event values to particles
+  // --------------------------------------------------------------------------
+  //! Particles of event i, in [offsets[i],
+  //! offsets[i + 1]), get perEvent[i], so event
+  //! constants can be used by kernels running over
+  //! a flat particle stream.
+  // ==========================================================================
+  template <typename T>
+  void Broadcast(const uint32_t* offsets, const std::size_t nEvents, const T* perEvent, T* perParticle) {
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      for (uint32_t iPar = offsets[iEvent]; iPar < offsets[iEvent + 1]; ++iPar) {
+        perParticle[iPar] = perEvent[iEvent];
+      }
+    }
+  }
+
+
+
+  // ==========================================================================
+  //! Sum per-particle values over each event
+  // --------------------------------------------------------------------------
+  //! Segmented reduction of a flat particle stream
+  //! along its offsets, the inverse of Broadcast().
+  //! Sums are kept in double precision.
+  // ==========================================================================
+  template <typename T>
+  void SegmentedSum(const uint32_t* offsets, const std::size_t nEvents, const T* perParticle, double* perEvent) {
+    for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+      double sum = 0.;
+      for (uint32_t iPar = offsets[iEvent]; iPar < offsets[iEvent + 1]; ++iPar) {
+        sum += perParticle[iPar];
+      }
+      perEvent[iEvent] = sum;
+    }
+  }
+
+
+
+  // ==========================================================================
+  //! Event batch
+  // --------------------------------------------------------------------------
+  //! A batch of extracted events: event-level
+  //! kinematics as one column per quantity, plus
+  //! reconstructed and generated particles.
+  //!
+  //! Lab-frame particles are optional: their
+  //! columns are either empty or hold one event per
+  //! event of the batch.
+  // ==========================================================================
+  struct EventBatch {
+    std::vector<uint64_t> key;       //!< (run << 32 | event) key
+    std::vector<float>    q2Rec;     //!< reconstructed Q2
+    std::vector<float>    q2Gen;     //!< generated Q2
+    std::vector<float>    xbRec;     //!< reconstructed xB
+    std::vector<float>    xbGen;     //!< generated xB
+    ParticleColumns       rec;       //!< reconstructed particles (breit frame)
+    ParticleColumns       gen;       //!< generated particles (breit frame)
+    ParticleColumns       recLab;    //!< reconstructed particles (head-on lab frame), optional
+    ParticleColumns       genLab;    //!< generated particles (head-on lab frame), optional
+    std::vector<int32_t>  recToGen;  //!< index of gen particle (within event) matched to each rec particle, -1 if none
+
+    std::size_t NEvents() const {return key.size();}
+
+    // check if lab-frame particles line up with events
+    bool HasRecLab() const {return recLab.NEvents() == NEvents();}
+    bool HasGenLab() const {return genLab.NEvents() == NEvents();}
+
+    // copy an event of another batch
+    void AddEvent(const EventBatch& from, const std::size_t iEvent) {
+      AddEvent(from, iEvent, from, iEvent);
+    }
+
+    // join the reconstructed side of one batch's event
+    // to the generated side of another's
+    //   - n.b. matching indices only carry over if
+    //     both sides are the same event and the
+    //     batch has them, otherwise rec particles
+    //     are left unmatched (-1)
+    void AddEvent(const EventBatch& recFrom, const std::size_t iRec, const EventBatch& genFrom, const std::size_t iGen) {
+      key.push_back(recFrom.key[iRec]);
+      q2Rec.push_back(recFrom.q2Rec[iRec]);
+      xbRec.push_back(recFrom.xbRec[iRec]);
+      q2Gen.push_back(genFrom.q2Gen[iGen]);
+      xbGen.push_back(genFrom.xbGen[iGen]);
+      rec.AddEvent(recFrom.rec.View(iRec));
+      gen.AddEvent(genFrom.gen.View(iGen));
+      if (recFrom.HasRecLab()) {
+        recLab.AddEvent(recFrom.recLab.View(iRec));
+      } else {
+        recLab.EndEvent();
+      }
+      if (genFrom.HasGenLab()) {
+        genLab.AddEvent(genFrom.genLab.View(iGen));
+      } else {
+        genLab.EndEvent();
+      }
+      const bool matched = (&recFrom == &genFrom) && (iRec == iGen) && (recFrom.recToGen.size() == recFrom.rec.Size());
+      if (matched) {
+        recToGen.insert(
+          recToGen.end(),
+          recFrom.recToGen.begin() + recFrom.rec.offsets[iRec],
+          recFrom.recToGen.begin() + recFrom.rec.offsets[iRec + 1]
+        );
+      } else {
+        recToGen.insert(recToGen.end(), recFrom.rec.View(iRec).size, -1);
+      }
+    }
+
+    void Clear() {
+      key.clear();
+      q2Rec.clear();
+      q2Gen.clear();
+      xbRec.clear();
+      xbGen.clear();
+      rec.Clear();
+      gen.Clear();
+      recLab.Clear();
+      genLab.Clear();
+      recToGen.clear();
+    }
+  };
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,69 @@
+// ============================================================================
+//! \file   EventSelector.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Event-level selection of a block of entries,
+//! evaluated column-wise into a bitmask.
+// ============================================================================
+
+#include "EventSelector.hxx"
+
+// c++ utilities
+#include <algorithm>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Select entries of a block
+  // --------------------------------------------------------------------------
+  //! Fills passed with the (block) indices of the
+  //! entries passing every predicate, in order, and
+  //! returns how many passed each step.
+  SelectionCounts EventSelector::Select(const SelectionColumns& in, std::vector<uint32_t>& passed) const {
+
+    SelectionCounts counts;
+    passed.clear();
+
+    const std::size_t nEntries = in.Size();
+    for (std::size_t first = 0; first < nEntries; first += 64) {
+      const std::size_t nLanes = std::min<std::size_t>(64, nEntries - first);
+
+      // one bit per entry and predicate
+      uint64_t kine     = 0;
+      uint64_t electron = 0;
+      uint64_t q2       = 0;
+      uint64_t xb       = 0;
+      for (std::size_t iLane = 0; iLane < nLanes; ++iLane) {
+        const std::size_t iEntry = first + iLane;
+        kine     |= static_cast<uint64_t>(in.hasKine[iEntry] != 0) << iLane;
+        electron |= static_cast<uint64_t>(in.hasElectron[iEntry] != 0) << iLane;
+        q2       |= static_cast<uint64_t>(InWindow(in.q2[iEntry], m_opt.minQ2, m_opt.maxQ2)) << iLane;
+        xb       |= static_cast<uint64_t>(InWindow(in.xb[iEntry], m_opt.minXB, m_opt.maxXB)) << iLane;
+      }
+
+      // combine in cut-flow order
+      uint64_t mask = kine;
+      counts.kine     += __builtin_popcountll(mask);
+      mask            &= electron;
+      counts.electron += __builtin_popcountll(mask);
+      mask            &= q2;
+      counts.q2       += __builtin_popcountll(mask);
+      mask            &= xb;
+      counts.xb       += __builtin_popcountll(mask);
+
+      // compact survivors
+      while (mask != 0) {
+        passed.push_back(first + __builtin_ctzll(mask));
+        mask &= mask - 1;
+      }
+    }
+    return counts;
+
+  }  // end 'Select(SelectionColumns&, std::vector<uint32_t>&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,123 @@
+// ============================================================================
+//! \file   EventSelector.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Event-level selection of a block of entries,
+//! evaluated column-wise into a bitmask.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_EventSelector_hxx
+#define EPNucleonEnergyCorrelator_EventSelector_hxx
+
+// c++ utilities
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Event selection options
+  // ==========================================================================
+  struct SelectionOptions {
+    double minQ2 = 0.0;                                       //!< min Q2 to extract
+    double maxQ2 = 100.0;                                     //!< max Q2 to extract
+    double minXB = -std::numeric_limits<double>::infinity();  //!< min xB to extract
+    double maxXB = std::numeric_limits<double>::infinity();   //!< max xB to extract
+  };
+
+
+
+  // ==========================================================================
+  //! Event-level quantities of a block of entries
+  // --------------------------------------------------------------------------
+  //! One column per quantity, indexed by entry
+  //! within the block. Q2 and xB of entries without
+  //! kinematics can be anything.
+  // ==========================================================================
+  struct SelectionColumns {
+    std::vector<uint8_t> hasKine;      //!< 1 if rec and gen inclusive kinematics were found
+    std::vector<uint8_t> hasElectron;  //!< 1 if a scattered electron was found
+    std::vector<float>   q2;           //!< Q2 to cut on
+    std::vector<float>   xb;           //!< xB to cut on
+
+    std::size_t Size() const {return q2.size();}
+
+    void Add(const bool kine, const bool electron, const float q2Val, const float xbVal) {
+      hasKine.push_back(kine);
+      hasElectron.push_back(electron);
+      q2.push_back(q2Val);
+      xb.push_back(xbVal);
+    }
+
+    void Clear() {
+      hasKine.clear();
+      hasElectron.clear();
+      q2.clear();
+      xb.clear();
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! No. of events passing each step of a selection
+  // --------------------------------------------------------------------------
+  //! Steps are cumulative, in this order.
+  // ==========================================================================
+  struct SelectionCounts {
+    uint64_t kine     = 0;  //!< events with inclusive kinematics
+    uint64_t electron = 0;  //!< ... and a scattered electron
+    uint64_t q2       = 0;  //!< ... and passing the Q2 cut
+    uint64_t xb       = 0;  //!< ... and inside the xB window
+  };
+
+
+
+  // ==========================================================================
+  //! Event selector
+  // --------------------------------------------------------------------------
+  //! Evaluates every predicate over a whole block
+  //! of entries at once, 64 entries to a mask word,
+  //! with branch-free loops the compiler vectorizes.
+  //! The masks are ANDed into one selection mask,
+  //! and indices of surviving entries compacted out
+  //! of it, so particles only need reading for
+  //! those. Windows are open, and a NaN passes them,
+  //! as with the per-event cuts this replaces.
+  // ==========================================================================
+  class EventSelector {
+
+    public:
+
+      // ctor/dtor
+      EventSelector(const SelectionOptions& opt = SelectionOptions()) : m_opt(opt) {};
+      ~EventSelector() {};
+
+      // interface
+      SelectionCounts Select(const SelectionColumns& in, std::vector<uint32_t>& passed) const;
+
+      // check a value against an open window
+      static bool InWindow(const double value, const double min, const double max) {
+        return !(value <= min) & !(value >= max);
+      }
+
+      // getters
+      const SelectionOptions& GetOptions() const {return m_opt;}
+
+    private:
+
+      // members
+      SelectionOptions m_opt;
+
+  };  // end EventSelector
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,208 @@
+// ============================================================================
+//! \file   EventShapes.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Breit-frame event shapes of the current
+//! hemisphere, its leading hadrons, and the
+//! largest rapidity gap of the event.
+// ============================================================================
+
+#include "EventShapes.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+
+
+namespace {
+
+  // mesons, baryons and nuclei have |pdg| >= 100
+  bool isHadron(const int32_t pdg) {
+    return std::abs(pdg) >= 100;
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Compute event shapes of one event
+  // --------------------------------------------------------------------------
+  void EventShapeCalculator::Compute(const ParticleView& pars, const double q2, EventShapes& shapes) {
+
+    shapes = EventShapes();
+
+    // collect current hemisphere and sums
+    m_px.clear();
+    m_py.clear();
+    m_pz.clear();
+    m_p.clear();
+
+    double sumE  = 0.;
+    double sumP  = 0.;
+    double sumPz = 0.;
+    double sumPt = 0.;
+    double vecX  = 0.;
+    double vecY  = 0.;
+    double vecZ  = 0.;
+    m_occupied.fill(0);
+    const double cellsPerY = NGapCells / (m_opt.gapMaxY - m_opt.gapMinY);
+    for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+      const double px = pars.px[iPar];
+      const double py = pars.py[iPar];
+      const double pz = pars.pz[iPar];
+      const double pt = std::hypot(px, py);
+      const double p  = std::hypot(pt, pz);
+
+      // mark rapidity cell, y = ln tan(theta / 2)
+      //   - n.b. tan(theta / 2) is written to avoid
+      //     cancellation in either hemisphere
+      const double      tanHalf = (pz >= 0.) ? pt / (p + pz) : (p - pz) / pt;
+      const double      cell    = (std::log(tanHalf) - m_opt.gapMinY) * cellsPerY;
+      const std::size_t iCell   = (cell >= 0.) ? static_cast<std::size_t>(std::min<double>(cell, NGapCells - 1)) : 0;
+      m_occupied[iCell / 64] |= uint64_t(1) << (iCell % 64);
+
+      if (!(pz < 0.)) continue;
+
+      // keep leading hadrons, hardest first
+      //   - n.b. xE holds the energy until the end
+      const double energy = pars.energy[iPar];
+      if (isHadron(pars.pdg[iPar]) && ((shapes.nLeading < NLeading) || (energy > shapes.leading[NLeading - 1].xE))) {
+        std::size_t slot = std::min(shapes.nLeading, NLeading - 1);
+        for (; (slot > 0) && (shapes.leading[slot - 1].xE < energy); --slot) {
+          shapes.leading[slot] = shapes.leading[slot - 1];
+        }
+        shapes.leading[slot] = {static_cast<int32_t>(iPar), pars.pdg[iPar], energy};
+        shapes.nLeading      = std::min(shapes.nLeading + 1, NLeading);
+      }
+      m_px.push_back(px);
+      m_py.push_back(py);
+      m_pz.push_back(pz);
+      m_p.push_back(p);
+
+      sumE  += energy;
+      sumP  += p;
+      sumPz += std::abs(pz);
+      sumPt += pt;
+      vecX  += px;
+      vecY  += py;
+      vecZ  += pz;
+    }
+
+    shapes.gap = Gap();
+
+    const double q  = std::sqrt(std::max(q2, 0.));
+    for (std::size_t iLead = 0; iLead < shapes.nLeading; ++iLead) {
+      shapes.leading[iLead].xE = (q > 0.) ? 2. * shapes.leading[iLead].xE / q : 0.;
+    }
+    shapes.nCurrent = m_p.size();
+    shapes.eCurrent = sumE;
+    shapes.valid    = (q > 0.) && (sumP > 0.) && (sumE > m_opt.minECurrent * q);
+    if (!shapes.valid) return;
+
+    // single-pass shapes
+    const double mass2 = sumE * sumE - (vecX * vecX + vecY * vecY + vecZ * vecZ);
+    shapes.tauQ = 1. - 2. * sumPz / q;
+    shapes.bQ   = sumPt / (2. * sumP);
+    shapes.rho  = std::max(mass2, 0.) / (4. * sumE * sumE);
+
+    // thrust axis search
+    shapes.tauC = 1. - Thrust(sumP);
+
+  }  // end 'Compute(ParticleView&, double, EventShapes&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Find thrust of current hemisphere
+  // --------------------------------------------------------------------------
+  //! n.b. at a fixed point n ~ sum sign(p.n) p, the
+  //! sum of |p.n| is just |sum sign(p.n) p|, so T is
+  //! read off the length of the last iterate.
+  double EventShapeCalculator::Thrust(const double sumP) {
+
+    const std::size_t nPar = m_p.size();
+    if (nPar < 2) return 1.;
+
+    // hardest particles seed the search
+    const std::size_t nSeed = std::min(std::max<std::size_t>(1, m_opt.nSeeds), nPar);
+    m_order.resize(nPar);
+    for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+      m_order[iPar] = iPar;
+    }
+    std::partial_sort(
+      m_order.begin(),
+      m_order.begin() + nSeed,
+      m_order.end(),
+      [this](const std::size_t a, const std::size_t b) {return m_p[a] > m_p[b];}
+    );
+
+    // iterate one seed to a local maximum
+    auto climb = [&](double nx, double ny, double nz) {
+      double best = 0.;
+      for (std::size_t iIter = 0; iIter < m_opt.maxIter; ++iIter) {
+        double sx = 0.;
+        double sy = 0.;
+        double sz = 0.;
+        for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+          const double sign = (m_px[iPar] * nx + m_py[iPar] * ny + m_pz[iPar] * nz >= 0.) ? 1. : -1.;
+          sx += sign * m_px[iPar];
+          sy += sign * m_py[iPar];
+          sz += sign * m_pz[iPar];
+        }
+        const double length = std::sqrt(sx * sx + sy * sy + sz * sz);
+        if (!(length > best * (1. + 1e-12))) break;
+        best = length;
+        nx   = sx;
+        ny   = sy;
+        nz   = sz;
+      }
+      return best;
+    };
+
+    double best = 0.;
+    for (std::size_t iSeed = 0; iSeed < nSeed; ++iSeed) {
+      const std::size_t i = m_order[iSeed];
+      best = std::max(best, climb(m_px[i], m_py[i], m_pz[i]));
+      for (std::size_t jSeed = iSeed + 1; jSeed < nSeed; ++jSeed) {
+        const std::size_t j = m_order[jSeed];
+        best = std::max(best, climb(m_px[i] + m_px[j], m_py[i] + m_py[j], m_pz[i] + m_pz[j]));
+        best = std::max(best, climb(m_px[i] - m_px[j], m_py[i] - m_py[j], m_pz[i] - m_pz[j]));
+      }
+    }
+    return std::min(best / sumP, 1.);
+
+  }  // end 'Thrust(double)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Find largest rapidity gap from the occupancy bitmap
+  // --------------------------------------------------------------------------
+  //! Visits only the occupied cells, lowest first,
+  //! so the cost doesn't depend on the grid size.
+  double EventShapeCalculator::Gap() const {
+
+    int64_t last = -1;
+    int64_t most = 0;
+    for (std::size_t iWord = 0; iWord < m_occupied.size(); ++iWord) {
+      for (uint64_t word = m_occupied[iWord]; word != 0; word &= word - 1) {
+        const int64_t cell = 64 * iWord + __builtin_ctzll(word);
+        if (last >= 0) {
+          most = std::max(most, cell - last - 1);
+        }
+        last = cell;
+      }
+    }
+    return most * (m_opt.gapMaxY - m_opt.gapMinY) / NGapCells;
+
+  }  // end 'Gap()'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
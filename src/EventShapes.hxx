@@ -0,0 +1,152 @@
+// ============================================================================
+//! \file   EventShapes.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Breit-frame event shapes of the current
+//! hemisphere, its leading hadrons, and the
+//! largest rapidity gap of the event.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_EventShapes_hxx
+#define EPNucleonEnergyCorrelator_EventShapes_hxx
+
+// c++ utilities
+#include <array>
+#include <cstdint>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // no. of leading hadrons kept per event
+  constexpr std::size_t NLeading = 3;
+
+
+
+  // ==========================================================================
+  //! One of the leading hadrons of the current hemisphere
+  // ==========================================================================
+  struct LeadingHadron {
+    int32_t index = -1;  //!< index of particle within event (-1 = none)
+    int32_t pdg   = 0;   //!< pdg code
+    double  xE    = 0.;  //!< energy fraction, 2 E / Q
+  };
+
+
+
+  // ==========================================================================
+  //! Event shapes of one event
+  // --------------------------------------------------------------------------
+  //! All shapes use the current hemisphere (pz < 0
+  //! in the Breit frame, i.e. the proton going to
+  //! +z) and follow the H1/ZEUS definitions. The
+  //! rapidity gap uses the whole event. The gap and
+  //! leading hadrons are set even if the shapes
+  //! aren't valid.
+  // ==========================================================================
+  struct EventShapes {
+    bool        valid    = false;  //!< current hemisphere energy above minECurrent * Q
+    std::size_t nCurrent = 0;      //!< no. of particles in current hemisphere
+    double      eCurrent = 0.;     //!< energy in current hemisphere
+    double      tauQ     = 1.;     //!< 1 - thrust wrt. photon axis, T = 2 sum |pz| / Q
+    double      tauC     = 1.;     //!< 1 - thrust wrt. thrust axis, T = max sum |p.n| / sum |p|
+    double      bQ       = 0.;     //!< broadening wrt. photon axis, sum pT / (2 sum |p|)
+    double      rho      = 0.;     //!< jet mass, M^2 / (4 E^2)
+    double      gap      = 0.;     //!< largest empty rapidity interval between two particles
+    std::size_t nLeading = 0;      //!< no. of leading hadrons found (at most NLeading)
+
+    std::array<LeadingHadron, NLeading> leading;  //!< hardest current hemisphere hadrons, by energy
+  };
+
+
+
+  // ==========================================================================
+  //! Event shape options
+  // ==========================================================================
+  struct EventShapeOptions {
+    double      minECurrent = 0.1;   //!< min current hemisphere energy over Q for valid shapes
+    std::size_t nSeeds      = 6;     //!< no. of hardest particles used to seed the thrust axis search
+    std::size_t maxIter     = 32;    //!< max iterations per seed
+    double      gapMinY     = -15.;  //!< low edge of rapidity grid for gap finding
+    double      gapMaxY     = 5.;    //!< high edge of rapidity grid for gap finding
+  };
+
+
+
+  // ==========================================================================
+  //! Event shape calculator
+  // --------------------------------------------------------------------------
+  //! Everything but the thrust axis is a single pass
+  //! over the current hemisphere. The thrust axis is
+  //! found by iterating n -> sum sign(p.n) p from
+  //! the directions of the nSeeds hardest particles
+  //! and their pairwise sums and differences: each
+  //! step can only raise T, so every seed converges
+  //! to a local maximum within a few steps, and the
+  //! largest is kept. That's O(nSeeds^2 N) per event
+  //! against O(N^3) for the exact search. On 10^4
+  //! random 1-3 jet events with 3-40 particles, the
+  //! default seeds miss the exact maximum in 1 event
+  //! and are 0.08% low in T there (see
+  //! bench/ThrustValidation.cxx).
+  //! The rapidity gap comes out of the same particle
+  //! loop without sorting: each particle sets the
+  //! bit of its cell in a fixed occupancy bitmap of
+  //! NGapCells cells over [gapMinY, gapMaxY) (cells
+  //! past either edge are clamped), and the gap is
+  //! the longest run of empty cells between two set
+  //! bits, found a word at a time. That's never
+  //! above the exact gap, and less than two cell
+  //! widths below it (0.16 in y by default).
+  //! Leading hadrons are also picked up in that
+  //! loop: a hadron harder than the softest of the
+  //! NLeading kept so far is inserted in place, so
+  //! it's O(NLeading) per candidate and nothing is
+  //! sorted.
+  //! Buffers are reused between events, so one
+  //! calculator should be kept per thread.
+  // ==========================================================================
+  class EventShapeCalculator {
+
+    public:
+
+      // no. of cells of the rapidity grid
+      static constexpr std::size_t NGapCells = 256;
+
+      // ctor/dtor
+      EventShapeCalculator(const EventShapeOptions& opt = EventShapeOptions()) : m_opt(opt) {};
+      ~EventShapeCalculator() {};
+
+      // interface
+      void Compute(const ParticleView& pars, const double q2, EventShapes& shapes);
+
+    private:
+
+      // helper methods
+      double Thrust(const double sumP);
+      double Gap() const;
+
+      // members
+      EventShapeOptions m_opt;
+
+      // current hemisphere momenta
+      std::vector<double>      m_px;
+      std::vector<double>      m_py;
+      std::vector<double>      m_pz;
+      std::vector<double>      m_p;
+      std::vector<std::size_t> m_order;
+
+      // rapidity occupancy bitmap
+      std::array<uint64_t, NGapCells / 64> m_occupied;
+
+  };  // end EventShapeCalculator
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -9,17 +9,252 @@
 
 #include "Extractor.hxx"
 
+// root libraries
+#include <TBranch.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderArray.h>
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+// package components
+#include "Logger.hxx"
+#include "SortedSkim.hxx"
+#include "TaskPool.hxx"
+
+
+
+namespace {
+
+  using namespace EPNucleonEnergyCorrelator;
+
+  // members read from each particle/kinematics collection
+  const std::vector<std::string> ParticleMembers   = {".energy", ".momentum.x", ".momentum.y", ".momentum.z", ".PDG"};
+  const std::vector<std::string> KinematicsMembers = {".Q2", ".x"};
+
+  // members of the MC particle collection beams are read from
+  const std::vector<std::string> MCMembers = {".generatorStatus", ".PDG", ".mass", ".momentum.x", ".momentum.y", ".momentum.z"};
+
+  // event header branches
+  const std::string RunBranch   = "EventHeader.runNumber";
+  const std::string EventBranch = "EventHeader.eventNumber";
+
+  // hepmc status codes
+  const int32_t FinalState = 1;
+  const int32_t Beam       = 4;
+
+
+
+  // --------------------------------------------------------------------------
+  //! No. of nucleons of a beam particle
+  // --------------------------------------------------------------------------
+  //! Ions have pdg codes 10LZZZAAAI, anything else
+  //! is taken to be a single nucleon.
+  double nNucleons(const int32_t pdg) {
+
+    const int32_t code = std::abs(pdg);
+    if (code < 1000000000) return 1.;
+
+    const int32_t nA = (code / 10) % 1000;
+    return (nA > 0) ? nA : 1.;
+
+  }  // end 'nNucleons(int32_t)'
+
+
+
+  // ==========================================================================
+  //! Reads the branches of one particle collection
+  // ==========================================================================
+  struct CollectionReader {
+    TTreeReaderArray<float> energy;
+    TTreeReaderArray<float> px;
+    TTreeReaderArray<float> py;
+    TTreeReaderArray<float> pz;
+    TTreeReaderArray<int>   pdg;
+
+    CollectionReader(TTreeReader& reader, const std::string& name) :
+      energy(reader, (name + ParticleMembers[0]).data()),
+      px(reader, (name + ParticleMembers[1]).data()),
+      py(reader, (name + ParticleMembers[2]).data()),
+      pz(reader, (name + ParticleMembers[3]).data()),
+      pdg(reader, (name + ParticleMembers[4]).data()) {}
+
+    // append particles of current entry (doesn't close the event)
+    void Fill(ParticleColumns& out) {
+      for (std::size_t iPar = 0; iPar < energy.GetSize(); ++iPar) {
+        out.Add(energy[iPar], px[iPar], py[iPar], pz[iPar], pdg[iPar]);
+      }
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! Reads the branches of one inclusive kinematics collection
+  // ==========================================================================
+  struct KinematicsReader {
+    TTreeReaderArray<float> q2;
+    TTreeReaderArray<float> xb;
+
+    KinematicsReader(TTreeReader& reader, const std::string& name) :
+      q2(reader, (name + KinematicsMembers[0]).data()),
+      xb(reader, (name + KinematicsMembers[1]).data()) {}
+  };
+
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read the beams from the first entry of a tree
+  // --------------------------------------------------------------------------
+  //! Beams are the first electron and the first
+  //! other particle with the beam status; the hadron
+  //! beam is taken per nucleon. Momentum is float or
+  //! double depending on the EDM4hep version, hence
+  //! the template.
+  template <typename T> bool readBeams(TTree* tree, const std::string& name, FourVector& eBeam, FourVector& hBeam) {
+
+    TTreeReader              reader(tree);
+    TTreeReaderArray<int>    status(reader, (name + MCMembers[0]).data());
+    TTreeReaderArray<int>    pdg(reader, (name + MCMembers[1]).data());
+    TTreeReaderArray<double> mass(reader, (name + MCMembers[2]).data());
+    TTreeReaderArray<T>      px(reader, (name + MCMembers[3]).data());
+    TTreeReaderArray<T>      py(reader, (name + MCMembers[4]).data());
+    TTreeReaderArray<T>      pz(reader, (name + MCMembers[5]).data());
+    if (reader.SetEntry(0) != TTreeReader::kEntryValid) return false;
+
+    bool foundE = false;
+    bool foundH = false;
+    for (std::size_t iPar = 0; iPar < status.GetSize(); ++iPar) {
+      if (status[iPar] != Beam) continue;
+
+      const double     p2   = px[iPar] * px[iPar] + py[iPar] * py[iPar] + pz[iPar] * pz[iPar];
+      const FourVector beam = {std::sqrt(p2 + mass[iPar] * mass[iPar]), px[iPar], py[iPar], pz[iPar]};
+      if ((pdg[iPar] == 11) && !foundE) {
+        eBeam  = beam;
+        foundE = true;
+      } else if ((pdg[iPar] != 11) && !foundH) {
+        hBeam  = beam * (1. / nNucleons(pdg[iPar]));
+        foundH = true;
+      }
+    }
+    return foundE && foundH;
+
+  }  // end 'readBeams(TTree*, std::string&, FourVector& x 2)'
+
+}  // end anonymous namespace
+
 
 
 namespace EPNucleonEnergyCorrelator {
 
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  Extractor::Extractor(const ExtractorOptions& opt) :
+    m_opt(opt),
+    m_selector(opt.select),
+    m_writer(opt.skim)
+  {
+
+    m_iCutRead       = m_cutFlow.Book("events read");
+    m_iCutKine       = m_cutFlow.Book("events with inclusive kinematics");
+    m_iCutElectron   = m_cutFlow.Book("events with a scattered electron");
+    m_iCutQ2         = m_cutFlow.Book("events passing Q2 cut");
+    m_iCutXB         = m_cutFlow.Book("events passing xB cut");
+    m_iCutPars       = m_cutFlow.Book("events with particles");
+    m_iCutDuplicates = m_cutFlow.Book("central/far-forward duplicate pairs removed");
+
+  }  // end ctor(ExtractorOptions&)
+
+
+
   // --------------------------------------------------------------------------
   //! Initialize class
   // --------------------------------------------------------------------------
-  //! FIXME might not be needed...
+  //! Brings the file metadata catalog up to date
+  //! (only files which are new or have changed since
+  //! the last job are reopened) and plans the work
+  //! units from it. HepMC3 ASCII files are instead
+  //! cut into byte ranges, and HepMC3 ROOT files are
+  //! one unit each.
   void Extractor::Init() {
 
-    /* TODO fill in */
+    // ROOT must be thread-safe before files are scanned in parallel
+    if (m_opt.nThreads > 1) {
+      ROOT::EnableThreadSafety();
+    }
+
+    // set up per-thread state
+    m_workers.clear();
+    for (unsigned iWorker = 0; iWorker < std::max(1u, m_opt.nThreads); ++iWorker) {
+      m_workers.emplace_back(new Worker(iWorker, m_opt, m_cutFlow));
+    }
+
+    // hepmc3 input doesn't use the catalog
+    if (m_opt.format != InputFormat::EICrecon) {
+      std::vector<int64_t> sizes(m_opt.inFiles.size(), -1);
+      if (m_opt.format == InputFormat::HepMC3Ascii) {
+        for (std::size_t iFile = 0; iFile < m_opt.inFiles.size(); ++iFile) {
+          FileIdentity id;
+          if (ProbeFile(m_opt.inFiles[iFile], id)) {
+            sizes[iFile] = id.size;
+          }
+        }
+      }
+      m_plan = PlanByteRanges(m_opt.inFiles, sizes, m_opt.unitBytes);
+      std::cout << "    Planned " << m_plan.size() << " work units over HepMC3 input" << std::endl;
+      return;
+    }
+
+    m_catalog.SetPath(m_opt.catalog);
+    if (!m_opt.catalog.empty() && !m_catalog.Load()) {
+      std::cout << "    No usable file catalog at '" << m_opt.catalog << "', building a new one" << std::endl;
+    }
+
+    const std::string tree    = m_opt.tree;
+    const std::string mcPars  = m_opt.mcPars;
+    const std::size_t nRescan = m_catalog.Refresh(
+      m_opt.inFiles,
+      tree,
+      mcPars,
+      &Extractor::ProbeFile,
+      [&tree, &mcPars](const FileIdentity& id, FileMetadata& meta) {
+        return Extractor::ScanFile(id, tree, meta, mcPars);
+      },
+      m_opt.nThreads
+    );
+    std::cout << "    Scanned " << nRescan << " of " << m_opt.inFiles.size() << " input files" << std::endl;
+
+    if (!m_opt.catalog.empty() && (nRescan > 0)) {
+      m_catalog.Save();
+    }
+
+    // build head-on frames of each file from the
+    // cached beams, if lab-frame particles are used
+    m_headOn.assign(m_opt.inFiles.size(), HeadOnFrame());
+    if (m_opt.headOn && (!m_opt.recParsLab.empty() || !m_opt.genParsLab.empty())) {
+      for (std::size_t iFile = 0; iFile < m_opt.inFiles.size(); ++iFile) {
+        const FileMetadata* meta = m_catalog.Find(m_opt.inFiles[iFile]);
+        if (!meta || !meta->hasBeams || !m_headOn[iFile].Build(meta->eBeam, meta->hBeam)) {
+          std::cerr << "WARNING: no beams in '" << m_opt.inFiles[iFile] << "', lab-frame particles won't be corrected for the crossing angle" << std::endl;
+        }
+      }
+    }
+
+    // plan work
+    m_plan = PlanWork(m_opt.inFiles, m_catalog, m_opt.unitSize);
+    std::cout << "    Planned " << m_plan.size() << " work units" << std::endl;
 
   }  // end 'Init()'
 
@@ -28,9 +263,31 @@ namespace EPNucleonEnergyCorrelator {
   // --------------------------------------------------------------------------
   //! Run extraction 
   // --------------------------------------------------------------------------
+  //! Work units are run on a work-stealing pool,
+  //! each worker fills its own batch and writes it
+  //! out as a skim cluster when full.
   void Extractor::Run() {
 
-    /* TODO fill in */
+    // n.b. a sorted skim is first written as sorted
+    // clusters, then merged at End()
+    const std::string path = m_opt.sorted ? m_opt.outFile + ".runs" : m_opt.outFile;
+    if (!m_writer.Open(path)) {
+      return;
+    }
+    m_lastKey = 0;
+    m_ordered = true;
+    std::cout << "    Opened output skim" << std::endl;
+
+    {
+      TaskPool pool(m_workers.size());
+      for (std::size_t iUnit = 0; iUnit < m_plan.size(); ++iUnit) {
+        pool.Submit([this, iUnit]() {
+          Extract(iUnit, TaskPool::WorkerIndex());
+        });
+      }
+      pool.Wait();
+    }
+    Flush();
 
   }  // end 'Run()'
 
@@ -38,13 +295,642 @@ namespace EPNucleonEnergyCorrelator {
   // --------------------------------------------------------------------------
   //! Finish 
   // --------------------------------------------------------------------------
-  //! FIXME might not be needed
+  //! If the clusters didn't come out in key order,
+  //! they're merged into a sorted skim here.
   void Extractor::End() {
 
-    /* TODO fill in */
+    m_writer.Close();
+    if (m_opt.sorted) {
+      const std::string runs = m_opt.outFile + ".runs";
+      if (m_ordered) {
+        std::rename(runs.data(), m_opt.outFile.data());
+      } else if (SortSkim(runs, m_opt.outFile, m_opt.skim, m_opt.batchSize, m_opt.sortFanIn)) {
+        std::remove(runs.data());
+      } else {
+        std::cerr << "WARNING: couldn't sort skim, unsorted clusters left in '" << runs << "'" << std::endl;
+      }
+    }
+    std::cout << "    Closed output skim ("
+              << m_writer.GetZipBytes() << " of " << m_writer.GetRawBytes() << " bytes after compression)\n"
+              << "    Cut flow:\n";
+    m_cutFlow.Print(std::cout);
+    std::cout << std::flush;
 
   }
 
+
+
+  // --------------------------------------------------------------------------
+  //! Extract one work unit on a worker
+  // --------------------------------------------------------------------------
+  //! Can be called concurrently as long as each call
+  //! uses a different worker.
+  bool Extractor::Extract(const std::size_t iUnit, const unsigned iWorker) {
+
+    const WorkUnit& unit = m_plan[iUnit];
+    if (!ExtractUnit(unit, *m_workers[iWorker])) {
+      EPNEC_LOG_WARNING("couldn't extract '%s' [%lld, %lld)", unit.path.data(), static_cast<long long>(unit.first), static_cast<long long>(unit.last));
+      return false;
+    }
+    EPNEC_LOG_DEBUG("extracted unit %zu on worker %u", iUnit, iWorker);
+    return true;
+
+  }  // end 'Extract(std::size_t, unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write out partial batches and collect cut flows
+  // --------------------------------------------------------------------------
+  //! Call once all units are extracted.
+  void Extractor::Flush() {
+
+    for (auto& worker : m_workers) {
+      if (worker->batch.NEvents() > 0) {
+        WriteBatch(*worker);
+      }
+      m_cutFlow.Merge(worker->cutFlow);
+      worker->cutFlow = CutFlow();
+    }
+
+  }  // end 'Flush()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Run only the I/O of an extraction
+  // --------------------------------------------------------------------------
+  //! Reads and decompresses exactly the branches the
+  //! current options need, over the same work units
+  //! and pool as Run(), but skips all selection,
+  //! matching and output. The result is the best
+  //! throughput a full run can reach on the storage.
+  IOStats Extractor::RunIOOnly() {
+
+    if (m_opt.format != InputFormat::EICrecon) {
+      std::cerr << "WARNING: I/O-only pass is only supported for EICrecon input" << std::endl;
+      return IOStats();
+    }
+
+    const std::vector<std::string> branches = GetBranches();
+    std::vector<IOStats>           perWorker(m_workers.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+      TaskPool pool(m_workers.size());
+      for (const auto& unit : m_plan) {
+        pool.Submit([this, &unit, &branches, &perWorker]() {
+          if (!ReadUnit(unit, branches, perWorker[TaskPool::WorkerIndex()])) {
+            EPNEC_LOG_WARNING("couldn't read '%s' [%lld, %lld)", unit.path.data(), static_cast<long long>(unit.first), static_cast<long long>(unit.last));
+          }
+        });
+      }
+      pool.Wait();
+    }
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+
+    IOStats total;
+    for (const auto& stats : perWorker) {
+      total.events   += stats.events;
+      total.zipBytes += stats.zipBytes;
+      total.rawBytes += stats.rawBytes;
+    }
+    total.seconds = took.count();
+
+    std::cout << "    I/O-only pass over " << branches.size() << " branches:\n"
+              << "      events:       " << total.events << " in " << total.seconds << " s\n"
+              << "      read:         " << (total.zipBytes / total.seconds) / 1e6 << " MB/s\n"
+              << "      decompressed: " << (total.rawBytes / total.seconds) / 1e6 << " MB/s\n"
+              << "      rate:         " << (total.events / total.seconds) << " events/s"
+              << std::endl;
+    return total;
+
+  }  // end 'RunIOOnly()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get names of all branches the current options read
+  // --------------------------------------------------------------------------
+  std::vector<std::string> Extractor::GetBranches() const {
+
+    std::vector<std::string> branches = {RunBranch, EventBranch};
+    for (const auto& kine : {m_opt.recKine, m_opt.genKine}) {
+      for (const auto& member : KinematicsMembers) {
+        branches.push_back(kine + member);
+      }
+    }
+
+    if (!m_opt.electrons.empty()) {
+      branches.push_back(m_opt.electrons + ParticleMembers[0]);
+    }
+
+    std::vector<std::string> collections = {m_opt.recParsBF, m_opt.genParsBF};
+    collections.insert(collections.end(), m_opt.recParsFF.begin(), m_opt.recParsFF.end());
+    for (const auto& lab : {m_opt.recParsLab, m_opt.genParsLab}) {
+      if (!lab.empty()) collections.push_back(lab);
+    }
+    for (const auto& collection : collections) {
+      for (const auto& member : ParticleMembers) {
+        branches.push_back(collection + member);
+      }
+    }
+    return branches;
+
+  }  // end 'GetBranches()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Extract selected events of a work unit
+  // --------------------------------------------------------------------------
+  //! Entries are taken in blocks of batchSize: the
+  //! event-level predicates of a whole block are
+  //! evaluated at once by the EventSelector, and
+  //! only the surviving entries are revisited for
+  //! their particles. Events are appended to the
+  //! worker's batch, which is written out whenever
+  //! it's full.
+  //!
+  //! Lab-frame particles are moved to the head-on
+  //! frame of the file in one pass over all those
+  //! added in a block (or since the last write).
+  //! Returns false if any entry of the unit can't
+  //! be read, so a corrupt or truncated unit is
+  //! reported rather than silently cut short.
+  bool Extractor::ExtractUnit(const WorkUnit& unit, Worker& worker) {
+
+    if (m_opt.format != InputFormat::EICrecon) {
+      return ExtractHepMC(unit, worker);
+    }
+
+    std::unique_ptr<TFile> file(TFile::Open(unit.path.data(), "read"));
+    if (!file || file->IsZombie()) {
+      return false;
+    }
+
+    TTreeReader           reader(m_opt.tree.data(), file.get());
+    TTreeReaderArray<int> run(reader, RunBranch.data());
+    TTreeReaderArray<int> event(reader, EventBranch.data());
+    KinematicsReader      recKine(reader, m_opt.recKine);
+    KinematicsReader      genKine(reader, m_opt.genKine);
+    CollectionReader      recPars(reader, m_opt.recParsBF);
+    CollectionReader      genPars(reader, m_opt.genParsBF);
+    if (reader.SetEntriesRange(unit.first, unit.last) != TTreeReader::kEntryValid) {
+      return false;
+    }
+
+    std::vector<std::unique_ptr<CollectionReader>> forPars;
+    for (const auto& name : m_opt.recParsFF) {
+      forPars.emplace_back(new CollectionReader(reader, name));
+    }
+
+    // n.b. branches are only read when accessed, so
+    // selecting a block reads the event-level ones
+    // alone, and particles are read just for the
+    // entries which pass
+    std::unique_ptr<TTreeReaderArray<float>> electrons;
+    if (!m_opt.electrons.empty()) {
+      electrons.reset(new TTreeReaderArray<float>(reader, (m_opt.electrons + ParticleMembers[0]).data()));
+    }
+
+    std::unique_ptr<CollectionReader> recLab;
+    std::unique_ptr<CollectionReader> genLab;
+    if (!m_opt.recParsLab.empty()) {
+      recLab.reset(new CollectionReader(reader, m_opt.recParsLab));
+    }
+    if (!m_opt.genParsLab.empty()) {
+      genLab.reset(new CollectionReader(reader, m_opt.genParsLab));
+    }
+
+    EventBatch&       batch  = worker.batch;
+    CutFlow&          cuts   = worker.cutFlow;
+    SelectionColumns& select = worker.select;
+    const int64_t     size   = std::max<std::size_t>(1, m_opt.batchSize);
+    const int64_t     last   = (unit.last < 0) ? reader.GetTree()->GetEntries() : unit.last;
+    bool              good   = true;
+
+    // correct lab-frame particles added since the
+    // last call
+    const HeadOnFrame& headOn  = m_headOn[unit.file];
+    std::size_t        recDone = batch.recLab.Size();
+    std::size_t        genDone = batch.genLab.Size();
+    auto toHeadOn = [&]() {
+      if (headOn.IsBuilt()) {
+        headOn.Apply(batch.recLab, recDone);
+        headOn.Apply(batch.genLab, genDone);
+      }
+      recDone = batch.recLab.Size();
+      genDone = batch.genLab.Size();
+    };
+
+    for (int64_t block = unit.first; good && (block < last); block += size) {
+      const int64_t end = std::min(block + size, last);
+
+      // apply event selection to the whole block
+      select.Clear();
+      for (int64_t entry = block; entry < end; ++entry) {
+        if (reader.SetEntry(entry) != TTreeReader::kEntryValid) {
+          good = false;
+          break;
+        }
+        const bool kine     = (recKine.q2.GetSize() > 0) && (genKine.q2.GetSize() > 0);
+        const bool electron = !electrons || (electrons->GetSize() > 0);
+        select.Add(kine, electron, kine ? recKine.q2[0] : 0.f, kine ? recKine.xb[0] : 0.f);
+      }
+      const SelectionCounts counts = m_selector.Select(select, worker.passed);
+      cuts.Count(m_iCutRead, select.Size());
+      cuts.Count(m_iCutKine, counts.kine);
+      cuts.Count(m_iCutElectron, counts.electron);
+      cuts.Count(m_iCutQ2, counts.q2);
+      cuts.Count(m_iCutXB, counts.xb);
+
+      for (const uint32_t iPassed : worker.passed) {
+        const int64_t entry = block + iPassed;
+        if (reader.SetEntry(entry) != TTreeReader::kEntryValid) {
+          good = false;
+          break;
+        }
+        if ((recPars.energy.GetSize() == 0) || (genPars.energy.GetSize() == 0)) continue;
+        cuts.Count(m_iCutPars);
+
+        // event-level info
+        const uint32_t runNum = (run.GetSize() > 0) ? run[0] : 0;
+        const uint32_t evtNum = (event.GetSize() > 0) ? event[0] : entry;
+        batch.key.push_back((static_cast<uint64_t>(runNum) << 32) | evtNum);
+        batch.q2Rec.push_back(recKine.q2[0]);
+        batch.q2Gen.push_back(genKine.q2[0]);
+        batch.xbRec.push_back(recKine.xb[0]);
+        batch.xbGen.push_back(genKine.xb[0]);
+
+        // reconstructed particles, combined with
+        // far-forward ones if requested
+        if (forPars.empty()) {
+          recPars.Fill(batch.rec);
+          batch.rec.EndEvent();
+        } else {
+          worker.central.Clear();
+          worker.forward.Clear();
+          recPars.Fill(worker.central);
+          worker.central.EndEvent();
+          for (auto& pars : forPars) {
+            pars->Fill(worker.forward);
+          }
+          worker.forward.EndEvent();
+          CombineEvent(worker);
+        }
+
+        // generated particles
+        genPars.Fill(batch.gen);
+        batch.gen.EndEvent();
+        MatchEvent(worker, batch.NEvents() - 1);
+
+        // lab-frame particles
+        if (recLab) {
+          recLab->Fill(batch.recLab);
+          batch.recLab.EndEvent();
+        }
+        if (genLab) {
+          genLab->Fill(batch.genLab);
+          batch.genLab.EndEvent();
+        }
+
+        if (batch.NEvents() >= m_opt.batchSize) {
+          toHeadOn();
+          WriteBatch(worker);
+          recDone = 0;
+          genDone = 0;
+        }
+      }
+      toHeadOn();
+    }
+    return good;
+
+  }  // end 'ExtractUnit(WorkUnit&, Worker&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Extract selected events of a HepMC3 work unit
+  // --------------------------------------------------------------------------
+  //! ASCII units are byte ranges of a memory-mapped
+  //! file, so any no. of workers can parse the same
+  //! file at once.
+  bool Extractor::ExtractHepMC(const WorkUnit& unit, Worker& worker) {
+
+    const bool       ascii = (m_opt.format == InputFormat::HepMC3Ascii);
+    HepMCAsciiReader asciiReader;
+    HepMCRootReader  rootReader;
+    if (ascii) {
+      if (!asciiReader.Open(unit.path)) return false;
+      asciiReader.Seek(unit.first, (unit.last < 0) ? asciiReader.Size() : unit.last);
+    } else if (!rootReader.Open(unit.path)) {
+      return false;
+    }
+
+    while (ascii ? asciiReader.Next(worker.hepmc) : rootReader.Next(worker.hepmc)) {
+      SelectHepMC(unit, worker);
+      if (worker.batch.NEvents() >= m_opt.batchSize) {
+        WriteBatch(worker);
+      }
+    }
+    return true;
+
+  }  // end 'ExtractHepMC(WorkUnit&, Worker&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Select a HepMC3 event and add it to the worker's batch
+  // --------------------------------------------------------------------------
+  //! The scattered electron is the hardest final-
+  //! state electron. The Breit frame is built from
+  //! it and the beams (per nucleon for ion beams),
+  //! and all other final-state particles are boosted
+  //! into it. There's no (run, event) key, so the
+  //! index of the file takes the place of the run.
+  //! Reconstructed kinematics are NaN and the
+  //! reconstructed particles are empty.
+  //!
+  //! If requested, final-state particles are also
+  //! kept in the lab frame, moved to the head-on
+  //! frame of the event's own beams; events whose
+  //! beams give no frame are logged and kept as is.
+  void Extractor::SelectHepMC(const WorkUnit& unit, Worker& worker) {
+
+    const HepMCEvent& event = worker.hepmc;
+    EventBatch&       batch = worker.batch;
+    CutFlow&          cuts  = worker.cutFlow;
+    cuts.Count(m_iCutRead);
+
+    // find beams and scattered electron
+    const HepMCParticle* eBeam  = nullptr;
+    const HepMCParticle* pBeam  = nullptr;
+    const HepMCParticle* eScat  = nullptr;
+    std::size_t          nFinal = 0;
+    for (const auto& par : event.particles) {
+      if (par.status == Beam) {
+        if (par.pdg == 11) {
+          if (!eBeam) eBeam = &par;
+        } else if (!pBeam) {
+          pBeam = &par;
+        }
+      } else if (par.status == FinalState) {
+        ++nFinal;
+        if ((par.pdg == 11) && (!eScat || (par.p.e > eScat->p.e))) {
+          eScat = &par;
+        }
+      }
+    }
+    if (!eBeam || !pBeam || !eScat) return;
+    if (!worker.breit.Build(eBeam->p, pBeam->p * (1. / nNucleons(pBeam->pdg)), eScat->p)) return;
+    cuts.Count(m_iCutKine);
+    cuts.Count(m_iCutElectron);
+
+    const SelectionOptions& cut = m_selector.GetOptions();
+    const double            q2  = worker.breit.GetQ2();
+    const double            xb  = worker.breit.GetXB();
+    if (!EventSelector::InWindow(q2, cut.minQ2, cut.maxQ2)) return;
+    cuts.Count(m_iCutQ2);
+    if (!EventSelector::InWindow(xb, cut.minXB, cut.maxXB)) return;
+    cuts.Count(m_iCutXB);
+    if (nFinal < 2) return;
+    cuts.Count(m_iCutPars);
+
+    // event-level info
+    const float noRec = std::numeric_limits<float>::quiet_NaN();
+    batch.key.push_back((static_cast<uint64_t>(unit.file) << 32) | event.number);
+    batch.q2Rec.push_back(noRec);
+    batch.q2Gen.push_back(q2);
+    batch.xbRec.push_back(noRec);
+    batch.xbGen.push_back(xb);
+    batch.rec.EndEvent();
+
+    // generated particles
+    for (const auto& par : event.particles) {
+      if ((par.status != FinalState) || (&par == eScat)) continue;
+      const FourVector p = worker.breit.Transform(par.p);
+      batch.gen.Add(p.e, p.px, p.py, p.pz, par.pdg);
+    }
+    batch.gen.EndEvent();
+
+    // lab-frame particles
+    if (m_opt.genParsLab.empty()) return;
+
+    const std::size_t first = batch.genLab.Size();
+    for (const auto& par : event.particles) {
+      if ((par.status != FinalState) || (&par == eScat)) continue;
+      batch.genLab.Add(par.p.e, par.p.px, par.p.py, par.p.pz, par.pdg);
+    }
+    batch.genLab.EndEvent();
+    if (!m_opt.headOn) return;
+    if (worker.headOn.Build(eBeam->p, pBeam->p * (1. / nNucleons(pBeam->pdg)))) {
+      worker.headOn.Apply(batch.genLab, first);
+    } else {
+      EPNEC_LOG_WARNING("no head-on frame for beams of event %lld in '%s', lab-frame particles won't be corrected for the crossing angle", static_cast<long long>(event.number), unit.path.data());
+    }
+
+  }  // end 'SelectHepMC(WorkUnit&, Worker&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read (and decompress) the branches of a work unit
+  // --------------------------------------------------------------------------
+  bool Extractor::ReadUnit(const WorkUnit& unit, const std::vector<std::string>& branches, IOStats& stats) {
+
+    std::unique_ptr<TFile> file(TFile::Open(unit.path.data(), "read"));
+    if (!file || file->IsZombie()) {
+      return false;
+    }
+
+    TTree* tree = file->Get<TTree>(m_opt.tree.data());
+    if (!tree) {
+      return false;
+    }
+
+    // enable and cache only the needed branches
+    const Long64_t last = (unit.last < 0) ? tree->GetEntries() : unit.last;
+    tree->SetBranchStatus("*", false);
+    for (const auto& branch : branches) {
+      tree->SetBranchStatus(branch.data(), true);
+    }
+    tree->SetCacheSize();
+    tree->SetCacheEntryRange(unit.first, last);
+    for (const auto& branch : branches) {
+      tree->AddBranchToCache(branch.data(), true);
+    }
+    tree->StopCacheLearningPhase();
+
+    for (Long64_t entry = unit.first; entry < last; ++entry) {
+      const Int_t nBytes = tree->GetEntry(entry);
+      if (nBytes < 0) return false;
+      stats.rawBytes += nBytes;
+      ++stats.events;
+    }
+    stats.zipBytes += file->GetBytesRead();
+    return true;
+
+  }  // end 'ReadUnit(WorkUnit&, std::vector<std::string>&, IOStats&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match reconstructed to generated particles of an event
+  // --------------------------------------------------------------------------
+  //! Appends the rec-to-gen indices of the event to
+  //! the worker's batch, so that there's always one
+  //! per rec particle. The Breit-frame collections
+  //! have no MC associations of their own, so in
+  //! association mode every rec particle is left
+  //! unmatched (-1).
+  void Extractor::MatchEvent(Worker& worker, const std::size_t iEvent) {
+
+    EventBatch& batch = worker.batch;
+    if (m_opt.match != MatchMode::DeltaR) {
+      batch.recToGen.insert(batch.recToGen.end(), batch.rec.View(iEvent).size, -1);
+      return;
+    }
+
+    worker.matcher.Match(batch.rec.View(iEvent), batch.gen.View(iEvent), worker.recToGen);
+    batch.recToGen.insert(batch.recToGen.end(), worker.recToGen.begin(), worker.recToGen.end());
+
+  }  // end 'MatchEvent(Worker&, std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Combine central and far-forward particles of an event
+  // --------------------------------------------------------------------------
+  //! Appends the particles of both collections to
+  //! the worker's batch, minus one particle of each
+  //! duplicate pair, and closes the event.
+  void Extractor::CombineEvent(Worker& worker) {
+
+    const ParticleView central = worker.central.View(0);
+    const ParticleView forward = worker.forward.View(0);
+    ParticleColumns&   out     = worker.batch.rec;
+    worker.cutFlow.Count(
+      m_iCutDuplicates,
+      worker.dedup.Resolve(central, forward, worker.keepCentral, worker.keepForward)
+    );
+
+    for (std::size_t iPar = 0; iPar < central.size; ++iPar) {
+      if (!worker.keepCentral[iPar]) continue;
+      out.Add(central.energy[iPar], central.px[iPar], central.py[iPar], central.pz[iPar], central.pdg[iPar]);
+    }
+    for (std::size_t iPar = 0; iPar < forward.size; ++iPar) {
+      if (!worker.keepForward[iPar]) continue;
+      out.Add(forward.energy[iPar], forward.px[iPar], forward.py[iPar], forward.pz[iPar], forward.pdg[iPar]);
+    }
+    out.EndEvent();
+
+  }  // end 'CombineEvent(Worker&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write a worker's batch as a skim cluster
+  // --------------------------------------------------------------------------
+  //! Or hand it to the sink, if one is set. Notes
+  //! whether clusters are still in global key order,
+  //! so End() can skip the merge if they are.
+  void Extractor::WriteBatch(Worker& worker) {
+
+    if (m_sink) {
+      m_sink(worker.batch, worker.index);
+    } else {
+      if (m_opt.sorted) {
+        SortBatch(worker.batch);
+      }
+
+      std::lock_guard<std::mutex> guard(m_writeLock);
+      if (!worker.batch.key.empty()) {
+        m_ordered = m_ordered && (worker.batch.key.front() >= m_lastKey);
+        m_lastKey = worker.batch.key.back();
+      }
+      m_writer.Write(worker.batch);
+    }
+    worker.batch.Clear();
+
+  }  // end 'WriteBatch(Worker&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get identity of a file without opening it
+  // --------------------------------------------------------------------------
+  //! n.b. TSystem dispatches on the url, so this is a
+  //! stat call over XRootD for root:// paths.
+  bool Extractor::ProbeFile(const std::string& path, FileIdentity& id) {
+
+    FileStat_t stat;
+    id.path = path;
+    if (gSystem->GetPathInfo(path.data(), stat) != 0) {
+      return false;
+    }
+    id.size  = stat.fSize;
+    id.mtime = stat.fMtime;
+    return true;
+
+  }  // end 'ProbeFile(std::string&, FileIdentity&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Open a file and collect its metadata
+  // --------------------------------------------------------------------------
+  //! Beams are read from the first entry of the MC
+  //! particles, if given and present.
+  bool Extractor::ScanFile(const FileIdentity& id, const std::string& tree, FileMetadata& meta, const std::string& mcPars) {
+
+    std::unique_ptr<TFile> file(TFile::Open(id.path.data(), "read"));
+    if (!file || file->IsZombie()) {
+      return false;
+    }
+
+    TTree* events = file->Get<TTree>(tree.data());
+    if (!events) {
+      return false;
+    }
+
+    // entries and cluster boundaries
+    meta.id      = id;
+    meta.tree    = tree;
+    meta.mcPars  = mcPars;
+    meta.entries = events->GetEntries();
+    meta.clusters.clear();
+
+    auto clusters = events->GetClusterIterator(0);
+    for (Long64_t start = clusters(); start < meta.entries; start = clusters()) {
+      meta.clusters.push_back(start);
+    }
+    meta.clusters.push_back(meta.entries);
+
+    // sizes of top-level branches (including sub-branches)
+    meta.branches.clear();
+    for (TObject* obj : *(events->GetListOfBranches())) {
+      TBranch* branch = static_cast<TBranch*>(obj);
+      meta.branches.push_back(
+        {branch->GetName(), branch->GetTotBytes("*"), branch->GetZipBytes("*")}
+      );
+    }
+
+    // beams
+    meta.hasBeams = false;
+    TLeaf* leaf   = mcPars.empty() ? nullptr : events->GetLeaf((mcPars + MCMembers[3]).data());
+    if (leaf && (meta.entries > 0)) {
+      const std::string type = leaf->GetTypeName();
+      if (type == "Double_t") {
+        meta.hasBeams = readBeams<double>(events, mcPars, meta.eBeam, meta.hBeam);
+      } else if (type == "Float_t") {
+        meta.hasBeams = readBeams<float>(events, mcPars, meta.eBeam, meta.hBeam);
+      }
+    }
+    return true;
+
+  }  // end 'ScanFile(FileIdentity&, std::string&, FileMetadata&, std::string&)'
+
 }  // end EPNucleonEnergyCorrelator namespace
 
 // end ========================================================================
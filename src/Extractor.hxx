@@ -7,38 +7,213 @@
 //! info.
 // ============================================================================
 
-/* TODO includes go here */
+#ifndef EPNucleonEnergyCorrelator_Extractor_hxx
+#define EPNucleonEnergyCorrelator_Extractor_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+// package components
+#include "CutFlow.hxx"
+#include "DuplicateRemover.hxx"
+#include "EventBatch.hxx"
+#include "EventSelector.hxx"
+#include "FileCatalog.hxx"
+#include "GridMatcher.hxx"
+#include "HeadOnFrame.hxx"
+#include "HepMCReader.hxx"
+#include "Skim.hxx"
+#include "WorkPlan.hxx"
 
 
 
 namespace EPNucleonEnergyCorrelator {
 
+  // ==========================================================================
+  //! How reconstructed particles are matched to generated ones
+  // ==========================================================================
+  enum class MatchMode {
+    Association,  //!< use MC associations from EICrecon (none for Breit-frame collections, so rec particles are unmatched)
+    DeltaR        //!< closest in (eta, phi), for collections without associations
+  };
+
+
+
+  // ==========================================================================
+  //! Format of the input files
+  // ==========================================================================
+  enum class InputFormat {
+    EICrecon,     //!< EICrecon output (reconstructed and generated)
+    HepMC3Ascii,  //!< HepMC3 ASCII generator output (generated only)
+    HepMC3Root    //!< HepMC3 ROOT-tree generator output (generated only, needs HepMC3)
+  };
+
+
+
+  // ==========================================================================
+  //! Extractor options
+  // ==========================================================================
+  struct ExtractorOptions {
+    std::vector<std::string> inFiles;                                          //!< input EICrecon or HepMC3 files
+    InputFormat              format     = InputFormat::EICrecon;               //!< format of input files
+    std::string              outFile    = "epnec.skim";                        //!< output skim
+    std::string              tree       = "events";                            //!< name of input tree
+    std::string              catalog    = "";                                  //!< path to file metadata catalog (empty = don't cache)
+    unsigned                 nThreads   = 1;                                   //!< no. of threads to use
+    MatchMode                match      = MatchMode::Association;              //!< rec-to-gen matching mode
+    GridMatcherOptions       matcher;                                          //!< options for delta-R matching
+    std::vector<std::string> recParsFF;                                        //!< far-forward reconstructed collections to combine with central ones
+    DuplicateOptions         dedup;                                            //!< options for central/far-forward duplicate removal
+    std::string              recParsBF  = "ReconstructedBreitFrameParticles";  //!< input reconstructed particles in breit frame
+    std::string              genParsBF  = "GeneratedBreitFrameParticles";      //!< input generated particles in breit frame
+    std::string              recParsLab = "";                                  //!< input reconstructed particles in lab frame (empty = don't extract)
+    std::string              genParsLab = "";                                  //!< input generated particles in lab frame (empty = don't extract; any name for HepMC3)
+    std::string              mcPars     = "MCParticles";                       //!< input MC particles to take beams from
+    bool                     headOn     = true;                                //!< correct lab-frame particles for the beam crossing angle
+    std::string              recKine    = "InclusiveKinematicsElectron";       //!< input reconstructed inclusive kinematics
+    std::string              genKine    = "InclusiveKinematicsTruth";          //!< input generated inclusive kinematics
+    std::string              electrons  = "";                                  //!< scattered electron collection required to be non-empty (empty = not required)
+    SelectionOptions         select;                                           //!< event selection cuts
+    std::size_t              batchSize  = 4096;                                //!< no. of events per skim cluster
+    int64_t                  unitSize   = 20000;                               //!< min no. of entries per work unit
+    int64_t                  unitBytes  = 64 << 20;                            //!< no. of bytes per work unit for HepMC3 ASCII input
+    SkimOptions              skim;                                             //!< skim compression options
+    bool                     sorted     = true;                                //!< sort output skim on the (run, event) key
+    std::size_t              sortFanIn  = 16;                                  //!< no. of runs merged at once when sorting
+  };
+
+
+
+  // ==========================================================================
+  //! Throughput of an I/O-only pass
+  // ==========================================================================
+  struct IOStats {
+    uint64_t events   = 0;   //!< no. of entries read
+    uint64_t zipBytes = 0;   //!< bytes read from storage
+    uint64_t rawBytes = 0;   //!< bytes after decompression
+    double   seconds  = 0.;  //!< wall time
+  };
+
+
+
   // ==========================================================================
   //! NEC Extractor
   // --------------------------------------------------------------------------
   //! Class to process EICrecon output and extract only 
   //! necessary information. Extracted information is
-  //! saved in an RNTuple to be processed downstream.
+  //! saved in a columnar skim to be processed downstream,
+  //! sorted on the (run, event) key unless turned off.
+  //! HepMC3 generator output can be read instead, for
+  //! generator-level studies: the generated particles
+  //! are boosted to the Breit frame here, and the
+  //! reconstructed side of the skim is left empty.
+  //!
+  //! Lab-frame particles can be extracted too. They
+  //! are moved to the head-on frame of each file,
+  //! built once from the beams cached in the file
+  //! catalog, so lab angles aren't smeared by the
+  //! beam crossing angle.
   // ==========================================================================
   class Extractor {
 
     public:
 
+      // receives full batches instead of the skim writer
+      using Sink = std::function<void(EventBatch&, const unsigned)>;
+
       // ctor/dtor
-      Extractor()  {};
+      Extractor(const ExtractorOptions& opt = ExtractorOptions());
       ~Extractor() {};
 
       // interface
       void Init();
       void Run();
       void End();
+      IOStats RunIOOnly();
+
+      // streaming interface
+      bool Extract(const std::size_t iUnit, const unsigned iWorker);
+      void Flush();
+      void SetSink(Sink sink) {m_sink = std::move(sink);}
+
+      // getters
+      const FileCatalog&       GetCatalog() const {return m_catalog;}
+      const CutFlow&           GetCutFlow() const {return m_cutFlow;}
+      std::vector<std::string> GetBranches() const;
+      std::size_t              NUnits() const {return m_plan.size();}
+      unsigned                 NWorkers() const {return m_workers.size();}
+
+      // static helpers for the file catalog
+      static bool ProbeFile(const std::string& path, FileIdentity& id);
+      static bool ScanFile(const FileIdentity& id, const std::string& tree, FileMetadata& meta, const std::string& mcPars = "");
 
     private:
 
-      /* TODO fill in */
+      // ======================================================================
+      //! Per-thread extraction state
+      // ======================================================================
+      struct Worker {
+        unsigned              index;
+        GridMatcher           matcher;
+        DuplicateRemover      dedup;
+        CutFlow               cutFlow;
+        EventBatch            batch;
+        ParticleColumns       central;
+        ParticleColumns       forward;
+        std::vector<int32_t>  recToGen;
+        std::vector<char>     keepCentral;
+        std::vector<char>     keepForward;
+        SelectionColumns      select;
+        std::vector<uint32_t> passed;
+        HepMCEvent            hepmc;
+        BreitFrame            breit;
+        HeadOnFrame           headOn;
+
+        Worker(const unsigned iWorker, const ExtractorOptions& opt, const CutFlow& cuts) :
+          index(iWorker),
+          matcher(opt.matcher),
+          dedup(opt.dedup),
+          cutFlow(cuts) {}
+      };
+
+      // helper methods
+      bool ExtractUnit(const WorkUnit& unit, Worker& worker);
+      bool ExtractHepMC(const WorkUnit& unit, Worker& worker);
+      void SelectHepMC(const WorkUnit& unit, Worker& worker);
+      bool ReadUnit(const WorkUnit& unit, const std::vector<std::string>& branches, IOStats& stats);
+      void MatchEvent(Worker& worker, const std::size_t iEvent);
+      void CombineEvent(Worker& worker);
+      void WriteBatch(Worker& worker);
+
+      // members
+      ExtractorOptions                     m_opt;
+      FileCatalog                          m_catalog;
+      std::vector<WorkUnit>                m_plan;
+      std::vector<HeadOnFrame>             m_headOn;
+      std::vector<std::unique_ptr<Worker>> m_workers;
+      EventSelector                        m_selector;
+      SkimWriter                           m_writer;
+      std::mutex                           m_writeLock;
+      uint64_t                             m_lastKey = 0;
+      bool                                 m_ordered = true;
+      Sink                                 m_sink;
+      CutFlow                              m_cutFlow;
+      std::size_t                          m_iCutRead;
+      std::size_t                          m_iCutKine;
+      std::size_t                          m_iCutElectron;
+      std::size_t                          m_iCutQ2;
+      std::size_t                          m_iCutXB;
+      std::size_t                          m_iCutPars;
+      std::size_t                          m_iCutDuplicates;
 
   };  // end Extractor
 
 }  // end EPNucleonEnergyCorrelator namespace
 
+#endif
+
 // end =======================================================================
@@ -0,0 +1,301 @@
+// ============================================================================
+//! \file   FileCatalog.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Persistent local catalog of input file metadata
+//! (entries, cluster boundaries, branch sizes,
+//! beams) so that planning doesn't need to reopen
+//! every file.
+// ============================================================================
+
+#include "FileCatalog.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+// package components
+#include "Logger.hxx"
+
+
+
+namespace {
+
+  // catalog file layout: magic, version, no. of
+  // records, then each FileMetadata field by field
+  //   - n.b. numbers are stored in native byte order,
+  //     the catalog is a local cache and not meant
+  //     to be shared between machines
+  constexpr char     Magic[8] = {'E', 'P', 'N', 'E', 'C', 'C', 'A', 'T'};
+  constexpr uint32_t Version  = 3;
+
+  template <typename T> void write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T> bool read(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+  }
+
+  void writeString(std::ostream& out, const std::string& str) {
+    write<uint32_t>(out, str.size());
+    out.write(str.data(), str.size());
+  }
+
+  // check the next n bytes fit in a stream of a
+  // given size, before anything is sized from them
+  bool fits(std::istream& in, const uint64_t streamSize, const uint64_t n) {
+    const std::streamoff pos = in.tellg();
+    return (pos >= 0) && (static_cast<uint64_t>(pos) <= streamSize) && (n <= streamSize - pos);
+  }
+
+  bool readString(std::istream& in, const uint64_t streamSize, std::string& str) {
+    uint32_t size = 0;
+    if (!read(in, size) || !fits(in, streamSize, size)) return false;
+    str.resize(size);
+    in.read(&str[0], size);
+    return in.good();
+  }
+
+  // run a function over indices [0, n) on nThreads threads
+  template <typename F> void parallelFor(const std::size_t n, const unsigned nThreads, F&& func) {
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+      for (std::size_t i = next++; i < n; i = next++) {
+        func(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned iThread = 1; iThread < std::min<std::size_t>(nThreads, n); ++iThread) {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Load catalog from disk
+  // --------------------------------------------------------------------------
+  //! Returns false (and leaves the catalog empty) if
+  //! the file is missing, corrupt or from another
+  //! version, in which case everything is rescanned.
+  //! Counts are checked against the bytes left in
+  //! the file before anything is sized from them.
+  bool FileCatalog::Load() {
+
+    m_entries.clear();
+    std::ifstream in(m_path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const uint64_t fileSize = in.tellg();
+    in.seekg(0);
+
+    char     magic[sizeof(Magic)];
+    uint32_t version  = 0;
+    uint64_t nRecords = 0;
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(Magic), Magic)) return false;
+    if (!read(in, version) || (version != Version)) return false;
+    if (!read(in, nRecords)) return false;
+
+    for (uint64_t iRecord = 0; iRecord < nRecords; ++iRecord) {
+
+      FileMetadata meta;
+      uint64_t     nClusters = 0;
+      uint64_t     nBranches = 0;
+      bool good = readString(in, fileSize, meta.id.path)
+               && read(in, meta.id.size)
+               && read(in, meta.id.mtime)
+               && readString(in, fileSize, meta.tree)
+               && readString(in, fileSize, meta.mcPars)
+               && read(in, meta.entries)
+               && read(in, nClusters)
+               && (nClusters <= fileSize / sizeof(int64_t))
+               && fits(in, fileSize, nClusters * sizeof(int64_t));
+      if (!good) {
+        m_entries.clear();
+        return false;
+      }
+
+      meta.clusters.resize(nClusters);
+      for (auto& cluster : meta.clusters) {
+        good = good && read(in, cluster);
+      }
+
+      // n.b. a branch takes at least its name's size
+      // and two byte counts
+      const uint64_t minBranch = sizeof(uint32_t) + 2 * sizeof(int64_t);
+      good = good
+          && read(in, nBranches)
+          && (nBranches <= fileSize / minBranch)
+          && fits(in, fileSize, nBranches * minBranch);
+      if (good) meta.branches.resize(nBranches);
+      for (auto& branch : meta.branches) {
+        good = good
+            && readString(in, fileSize, branch.name)
+            && read(in, branch.totBytes)
+            && read(in, branch.zipBytes);
+      }
+
+      uint8_t hasBeams = 0;
+      good = good
+          && read(in, hasBeams)
+          && read(in, meta.eBeam)
+          && read(in, meta.hBeam);
+      meta.hasBeams = (hasBeams != 0);
+      if (!good) {
+        m_entries.clear();
+        return false;
+      }
+      m_entries[meta.id.path] = std::move(meta);
+    }
+    return true;
+
+  }  // end 'Load()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Save catalog to disk
+  // --------------------------------------------------------------------------
+  //! Writes to a temporary file first and renames it,
+  //! so an interrupted job never leaves a truncated
+  //! catalog behind. The temporary file is removed
+  //! if either step fails.
+  bool FileCatalog::Save() const {
+
+    const std::string temp = m_path + ".tmp";
+    {
+      std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        std::cerr << "WARNING: couldn't write file catalog '" << temp << "'" << std::endl;
+        return false;
+      }
+
+      out.write(Magic, sizeof(Magic));
+      write<uint32_t>(out, Version);
+      write<uint64_t>(out, m_entries.size());
+      for (const auto& entry : m_entries) {
+        const FileMetadata& meta = entry.second;
+        writeString(out, meta.id.path);
+        write(out, meta.id.size);
+        write(out, meta.id.mtime);
+        writeString(out, meta.tree);
+        writeString(out, meta.mcPars);
+        write(out, meta.entries);
+        write<uint64_t>(out, meta.clusters.size());
+        for (const int64_t cluster : meta.clusters) {
+          write(out, cluster);
+        }
+        write<uint64_t>(out, meta.branches.size());
+        for (const auto& branch : meta.branches) {
+          writeString(out, branch.name);
+          write(out, branch.totBytes);
+          write(out, branch.zipBytes);
+        }
+        write<uint8_t>(out, meta.hasBeams);
+        write(out, meta.eBeam);
+        write(out, meta.hBeam);
+      }
+      out.close();
+      if (!out) {
+        std::cerr << "WARNING: couldn't write file catalog '" << temp << "'" << std::endl;
+        std::remove(temp.data());
+        return false;
+      }
+    }
+    if (std::rename(temp.data(), m_path.data()) != 0) {
+      std::cerr << "WARNING: couldn't move file catalog into place at '" << m_path << "'" << std::endl;
+      std::remove(temp.data());
+      return false;
+    }
+    return true;
+
+  }  // end 'Save()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Bring catalog up to date with a list of files
+  // --------------------------------------------------------------------------
+  //! Probes every file and rescans those which are
+  //! new, changed, or were scanned for another tree
+  //! or MC particles, both in parallel. Entries of
+  //! files not in the list are kept. Returns the
+  //! no. of files which were (re)scanned.
+  std::size_t FileCatalog::Refresh(
+    const std::vector<std::string>& files,
+    const std::string& tree,
+    const std::string& mcPars,
+    const Prober& probe,
+    const Scanner& scan,
+    const unsigned nThreads
+  ) {
+
+    // probe all files, collect those out of date
+    std::vector<FileIdentity> ids(files.size());
+    std::vector<char>         stale(files.size(), 0);
+    parallelFor(files.size(), nThreads, [&](const std::size_t iFile) {
+      ids[iFile].path = files[iFile];
+      if (!probe(files[iFile], ids[iFile])) {
+        EPNEC_LOG_WARNING("couldn't probe '%s', rescanning", files[iFile].data());
+      }
+      auto cached = m_entries.find(files[iFile]);
+      stale[iFile] = (cached == m_entries.end())
+                  || (cached->second.id != ids[iFile])
+                  || (cached->second.tree != tree)
+                  || (cached->second.mcPars != mcPars)
+                  || (ids[iFile].size < 0);
+    });
+
+    std::vector<std::size_t> toScan;
+    for (std::size_t iFile = 0; iFile < files.size(); ++iFile) {
+      if (stale[iFile]) toScan.push_back(iFile);
+    }
+
+    // rescan stale files
+    std::mutex  lock;
+    std::size_t nScanned = 0;
+    parallelFor(toScan.size(), nThreads, [&](const std::size_t iScan) {
+      FileMetadata meta;
+      meta.id = ids[toScan[iScan]];
+      if (!scan(meta.id, meta)) {
+        EPNEC_LOG_WARNING("couldn't scan '%s'", meta.id.path.data());
+        return;
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      m_entries[meta.id.path] = std::move(meta);
+      ++nScanned;
+    });
+    return nScanned;
+
+  }  // end 'Refresh(std::vector<std::string>&, std::string&, std::string&, Prober&, Scanner&, unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Look up metadata of a file
+  // --------------------------------------------------------------------------
+  const FileMetadata* FileCatalog::Find(const std::string& file) const {
+
+    auto entry = m_entries.find(file);
+    return (entry == m_entries.end()) ? nullptr : &(entry->second);
+
+  }  // end 'Find(std::string&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,132 @@
+// ============================================================================
+//! \file   FileCatalog.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Persistent local catalog of input file metadata
+//! (entries, cluster boundaries, branch sizes,
+//! beams) so that planning doesn't need to reopen
+//! every file.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_FileCatalog_hxx
+#define EPNucleonEnergyCorrelator_FileCatalog_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+// package components
+#include "BreitFrame.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! File identity
+  // --------------------------------------------------------------------------
+  //! A cached entry is only trusted while the path,
+  //! size and modification time of the file are
+  //! unchanged.
+  // ==========================================================================
+  struct FileIdentity {
+    std::string path;        //!< path or url of file
+    int64_t     size  = -1;  //!< size of file in bytes
+    int64_t     mtime = -1;  //!< last modification time (unix seconds)
+
+    bool operator==(const FileIdentity& other) const {
+      return (path == other.path) && (size == other.size) && (mtime == other.mtime);
+    }
+    bool operator!=(const FileIdentity& other) const {
+      return !(*this == other);
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! Branch size information
+  // ==========================================================================
+  struct BranchInfo {
+    std::string name;           //!< (top-level) branch name
+    int64_t     totBytes = 0;   //!< uncompressed size in bytes
+    int64_t     zipBytes = 0;   //!< compressed size in bytes
+  };
+
+
+
+  // ==========================================================================
+  //! Cached metadata of one input file
+  // ==========================================================================
+  struct FileMetadata {
+    FileIdentity            id;                //!< identity of file when scanned
+    std::string             tree;              //!< name of scanned tree
+    std::string             mcPars;            //!< MC particles beams were looked for in
+    int64_t                 entries  = 0;      //!< no. of entries in tree
+    std::vector<int64_t>    clusters;          //!< first entry of each cluster, plus no. of entries
+    std::vector<BranchInfo> branches;          //!< per-branch sizes
+    bool                    hasBeams = false;  //!< whether beams were found
+    FourVector              eBeam;             //!< electron beam (lab frame)
+    FourVector              hBeam;             //!< hadron beam, per nucleon (lab frame)
+  };
+
+
+
+  // ==========================================================================
+  //! File metadata catalog
+  // --------------------------------------------------------------------------
+  //! Keeps per-file metadata in a compact binary file
+  //! keyed by file path. On Refresh() every input is
+  //! probed (cheap stat) in parallel and only files
+  //! whose identity changed, or which were scanned
+  //! with another tree or MC particles, are
+  //! rescanned.
+  // ==========================================================================
+  class FileCatalog {
+
+    public:
+
+      // probe fills identity of a path, scanner fills metadata of a file
+      using Prober  = std::function<bool(const std::string&, FileIdentity&)>;
+      using Scanner = std::function<bool(const FileIdentity&, FileMetadata&)>;
+
+      // ctor/dtor
+      FileCatalog(const std::string& path = "") : m_path(path) {};
+      ~FileCatalog() {};
+
+      // interface
+      bool        Load();
+      bool        Save() const;
+      std::size_t Refresh(
+        const std::vector<std::string>& files,
+        const std::string& tree,
+        const std::string& mcPars,
+        const Prober& probe,
+        const Scanner& scan,
+        const unsigned nThreads = 1
+      );
+
+      // getters
+      const FileMetadata* Find(const std::string& file) const;
+      std::size_t         Size() const {return m_entries.size();}
+      const std::string&  GetPath() const {return m_path;}
+
+      // setters
+      void SetPath(const std::string& path) {m_path = path;}
+
+    private:
+
+      // members
+      std::string                         m_path;
+      std::map<std::string, FileMetadata> m_entries;
+
+  };  // end FileCatalog
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
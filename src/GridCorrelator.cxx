@@ -0,0 +1,267 @@
+// ============================================================================
+//! \file   GridCorrelator.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Approximate energy-energy correlator of an
+//! event, from the autocorrelation of its energy
+//! deposited on a (rapidity, phi) grid.
+// ============================================================================
+
+#include "GridCorrelator.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+
+namespace {
+
+  constexpr double Pi = 3.14159265358979;
+
+  // round up to a power of 2
+  std::size_t ceilPow2(const std::size_t size) {
+    std::size_t pow2 = 1;
+    while (pow2 < size) {
+      pow2 <<= 1;
+    }
+    return pow2;
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Tabulate twiddles and bit reversal of a size
+  // --------------------------------------------------------------------------
+  //! Size is rounded up to a power of 2.
+  void FFT::Resize(const std::size_t size) {
+
+    m_size = ceilPow2(size);
+
+    m_twiddles.resize(m_size / 2);
+    for (std::size_t k = 0; k < m_twiddles.size(); ++k) {
+      m_twiddles[k] = std::polar(1., -2. * Pi * k / m_size);
+    }
+
+    std::size_t nBits = 0;
+    while ((std::size_t(1) << nBits) < m_size) {
+      ++nBits;
+    }
+    m_reverse.resize(m_size);
+    for (std::size_t index = 0; index < m_size; ++index) {
+      uint32_t reverse = 0;
+      for (std::size_t bit = 0; bit < nBits; ++bit) {
+        reverse |= ((index >> bit) & 1) << (nBits - 1 - bit);
+      }
+      m_reverse[index] = reverse;
+    }
+
+  }  // end 'Resize(std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Transform GetSize() values in place
+  // --------------------------------------------------------------------------
+  //! n.b. butterflies multiply out real and
+  //! imaginary parts by hand, as std::complex's
+  //! operator* checks for infinities on every call.
+  void FFT::Transform(std::complex<double>* data, const bool inverse) const {
+
+    for (std::size_t index = 0; index < m_size; ++index) {
+      if (index < m_reverse[index]) std::swap(data[index], data[m_reverse[index]]);
+    }
+
+    const double sign = inverse ? -1. : 1.;
+    for (std::size_t half = 1; half < m_size; half <<= 1) {
+      const std::size_t step = m_size / (2 * half);
+      for (std::size_t start = 0; start < m_size; start += 2 * half) {
+        for (std::size_t k = 0; k < half; ++k) {
+          const double twRe = m_twiddles[k * step].real();
+          const double twIm = m_twiddles[k * step].imag() * sign;
+          const double hiRe = data[start + k + half].real();
+          const double hiIm = data[start + k + half].imag();
+          const std::complex<double> odd(twRe * hiRe - twIm * hiIm, twRe * hiIm + twIm * hiRe);
+          const std::complex<double> even = data[start + k];
+          data[start + k]        = std::complex<double>(even.real() + odd.real(), even.imag() + odd.imag());
+          data[start + k + half] = std::complex<double>(even.real() - odd.real(), even.imag() - odd.imag());
+        }
+      }
+    }
+
+  }  // end 'Transform(std::complex<double>*, bool)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Make a correlator with cells of cellY x 2pi/nPhi
+  // --------------------------------------------------------------------------
+  //! nPhi is rounded up to a power of 2.
+  GridCorrelator::GridCorrelator(const double cellY, const std::size_t nPhi) :
+    m_cellY(cellY > 0. ? cellY : 0.04),
+    m_nPhi(ceilPow2(std::max<std::size_t>(1, nPhi))),
+    m_fftPhi(m_nPhi) {
+
+    // squared phi distance of each phi lag
+    const double cellPhi = 2. * Pi / m_nPhi;
+    m_dPhi2.resize(m_nPhi);
+    for (std::size_t lag = 0; lag < m_nPhi; ++lag) {
+      const double dPhi = std::min(lag, m_nPhi - lag) * cellPhi;
+      m_dPhi2[lag] = dPhi * dPhi;
+    }
+
+  }  // end ctor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill the correlator of an event
+  // --------------------------------------------------------------------------
+  //! Adds the summed weight and squared weight of
+  //! the pairs in each dR bin, and counts one entry
+  //! per pair, like the exact pair loop. Particles
+  //! with a non-finite y or phi are skipped, and
+  //! lags with less than 1e-12 of the total weight
+  //! squared (FFT round-off) dropped.
+  void GridCorrelator::Fill(const float* y, const float* phi, const float* w, const std::size_t nPar, Hist1D& hist) {
+
+    // rapidity span of the event
+    double      yMin   = std::numeric_limits<double>::infinity();
+    double      yMax   = -std::numeric_limits<double>::infinity();
+    double      sumW   = 0.;
+    double      sumW2  = 0.;
+    double      sumW4  = 0.;
+    std::size_t nValid = 0;
+    for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+      if (!std::isfinite(y[iPar]) || !std::isfinite(phi[iPar])) continue;
+      ++nValid;
+      yMin   = std::min<double>(yMin, y[iPar]);
+      yMax   = std::max<double>(yMax, y[iPar]);
+      sumW  += w[iPar];
+      sumW2 += w[iPar] * w[iPar];
+      sumW4 += w[iPar] * w[iPar] * w[iPar] * w[iPar];
+    }
+    if (!(yMax >= yMin)) return;
+
+    // pad rapidity to twice the span, so lags don't wrap
+    const std::size_t nCellsY = static_cast<std::size_t>((yMax - yMin) / m_cellY) + 1;
+    const std::size_t nY      = ceilPow2(2 * nCellsY - 1);
+    if (m_fftY.GetSize() != nY) m_fftY.Resize(nY);
+    m_grid.assign(nY * m_nPhi, 0.);
+    m_column.resize(nY);
+    m_mirror.resize(nY);
+
+    // deposit weights, and squared weights for the
+    // errors alongside them
+    const double perPhi = m_nPhi / (2. * Pi);
+    for (std::size_t iPar = 0; iPar < nPar; ++iPar) {
+      if (!std::isfinite(y[iPar]) || !std::isfinite(phi[iPar])) continue;
+      const std::size_t iY   = std::min(nCellsY - 1, static_cast<std::size_t>((y[iPar] - yMin) / m_cellY));
+      long              iPhi = static_cast<long>(std::floor((phi[iPar] + Pi) * perPhi)) % static_cast<long>(m_nPhi);
+      if (iPhi < 0) iPhi += m_nPhi;
+      m_grid[iY * m_nPhi + iPhi] += std::complex<double>(w[iPar], double(w[iPar]) * w[iPar]);
+    }
+
+    // transform along phi; rows past the span are
+    // still zero
+    for (std::size_t iY = 0; iY < nCellsY; ++iY) {
+      m_fftPhi.Transform(&m_grid[iY * m_nPhi], false);
+    }
+
+    // along y: transform, take the power spectra,
+    // and transform back, a column and its mirror
+    // in phi at a time
+    //   - n.b. for a grid g = w + i w^2, the spectra
+    //     of w and w^2 are (G(k) +- G*(-k)) / 2, so
+    //     both come out of one transform
+    for (std::size_t iPhi = 0; iPhi <= m_nPhi / 2; ++iPhi) {
+      const std::size_t jPhi = (m_nPhi - iPhi) % m_nPhi;
+      for (std::size_t iY = 0; iY < nY; ++iY) {
+        m_column[iY] = m_grid[iY * m_nPhi + iPhi];
+        m_mirror[iY] = m_grid[iY * m_nPhi + jPhi];
+      }
+      // n.b. a column can be its own mirror, and
+      // power spectra are the same at k and -k
+      std::vector<std::complex<double>>& mirror = (jPhi != iPhi) ? m_mirror : m_column;
+      m_fftY.Transform(m_column.data(), false);
+      if (jPhi != iPhi) m_fftY.Transform(m_mirror.data(), false);
+      for (std::size_t iY = 0; iY < ((jPhi != iPhi) ? nY : nY / 2 + 1); ++iY) {
+        const std::size_t          jY    = (nY - iY) % nY;
+        const std::complex<double> here  = m_column[iY];
+        const std::complex<double> there = std::conj(mirror[jY]);
+        const std::complex<double> power(0.25 * std::norm(here + there), 0.25 * std::norm(here - there));
+        m_column[iY] = power;
+        mirror[jY]   = power;
+      }
+      m_fftY.Transform(m_column.data(), true);
+      if (jPhi != iPhi) m_fftY.Transform(m_mirror.data(), true);
+
+      for (std::size_t iY = 0; iY < nY; ++iY) {
+        m_grid[iY * m_nPhi + iPhi] = m_column[iY];
+        m_grid[iY * m_nPhi + jPhi] = mirror[iY];
+      }
+    }
+
+    // back along phi for rows of lags inside the
+    // span, and sum lags into dR bins: the real
+    // part is the summed w_i w_j of pairs at a lag,
+    // the imaginary part their summed (w_i w_j)^2
+    // n.b. each pair shows up at a lag and its
+    // opposite, hence the half
+    const Axis&  axis  = hist.GetX();
+    const double scale = 1. / (nY * m_nPhi);
+    const double floor = 1e-12 * sumW * sumW;
+    m_bins.assign(axis.num + 2, 0.);
+    m_bins2.assign(axis.num + 2, 0.);
+    for (std::size_t iY = 0; iY < nY; ++iY) {
+      if ((iY >= nCellsY) && (iY <= nY - nCellsY)) continue;
+
+      const double lag = (iY < nCellsY) ? double(iY) : double(iY) - double(nY);
+      const double dY2 = (lag * m_cellY) * (lag * m_cellY);
+
+      std::complex<double>* row = &m_grid[iY * m_nPhi];
+      m_fftPhi.Transform(row, true);
+      for (std::size_t iPhi = 0; iPhi < m_nPhi; ++iPhi) {
+        double weight  = row[iPhi].real() * scale;
+        double weight2 = row[iPhi].imag() * scale;
+        if ((iY == 0) && (iPhi == 0)) {
+          weight  -= sumW2;
+          weight2 -= sumW4;
+        }
+        if (!(weight > floor)) continue;
+
+        const std::size_t bin = axis.Find(std::sqrt(dY2 + m_dPhi2[iPhi]));
+        m_bins[bin]  += 0.5 * weight;
+        m_bins2[bin] += 0.5 * std::max(weight2, 0.);
+      }
+    }
+
+    const double entries = hist.GetEntries();
+    for (std::size_t bin = 0; bin < m_bins.size(); ++bin) {
+      if (m_bins[bin] > 0.) hist.AddBin(bin, m_bins[bin], m_bins2[bin]);
+    }
+    hist.SetEntries(entries + 0.5 * nValid * (nValid - 1.));
+
+  }  // end 'Fill(float*, float*, float*, std::size_t, Hist1D&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Bound on the dR error of a pair: a cell diagonal
+  // --------------------------------------------------------------------------
+  double GridCorrelator::GetMaxError() const {
+
+    return std::hypot(m_cellY, 2. * Pi / m_nPhi);
+
+  }  // end 'GetMaxError()'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,124 @@
+// ============================================================================
+//! \file   GridCorrelator.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Approximate energy-energy correlator of an
+//! event, from the autocorrelation of its energy
+//! deposited on a (rapidity, phi) grid.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_GridCorrelator_hxx
+#define EPNucleonEnergyCorrelator_GridCorrelator_hxx
+
+// c++ utilities
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+// package components
+#include "Histogram.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Complex FFT of one power-of-2 size
+  // --------------------------------------------------------------------------
+  //! Iterative radix-2 transform, in place, with
+  //! twiddles and the bit-reversal permutation
+  //! tabulated once per size. Transforms aren't
+  //! normalized, so an inverse after a forward
+  //! one scales by the size.
+  // ==========================================================================
+  class FFT {
+
+    public:
+
+      // ctor/dtor
+      FFT(const std::size_t size = 1) {Resize(size);}
+      ~FFT() {};
+
+      // interface
+      void Resize(const std::size_t size);
+      void Transform(std::complex<double>* data, const bool inverse) const;
+
+      // getters
+      std::size_t GetSize() const {return m_size;}
+
+    private:
+
+      // members
+      std::size_t                       m_size = 0;
+      std::vector<std::complex<double>> m_twiddles;
+      std::vector<uint32_t>             m_reverse;
+
+  };  // end FFT
+
+
+
+  // ==========================================================================
+  //! Grid energy-energy correlator
+  // --------------------------------------------------------------------------
+  //! Fills sum_{i<j} w_i w_j vs. dR_ij = sqrt(dy^2
+  //! + dphi^2) of an event without a pair loop:
+  //! weights are summed into cells of cellY x
+  //! 2pi/nPhi, and the autocorrelation of the grid,
+  //! computed with FFTs, is the summed weight of
+  //! pairs at each (dy, dphi) lag. Each lag is then
+  //! added to the dR bin it falls in. Cost goes as
+  //! the no. of cells spanned, not as n^2. Squared
+  //! weights ride along in the imaginary part of
+  //! the grid, so bin errors are those of a pair
+  //! loop.
+  //!
+  //! The grid is padded in rapidity, so lags don't
+  //! wrap, but not in phi, which is periodic. Self
+  //! pairs are taken off the zero lag exactly; other
+  //! pairs sharing a cell land in dR = 0. Since each
+  //! particle is moved by less than a cell in y and
+  //! phi, the dR a pair is filled at is off by less
+  //! than a cell diagonal (GetMaxError()), so cells
+  //! should be well below the dR bin width.
+  //!
+  //! Keeps the grid between events, so use one per
+  //! thread.
+  // ==========================================================================
+  class GridCorrelator {
+
+    public:
+
+      // ctor/dtor
+      GridCorrelator(const double cellY = 0.04, const std::size_t nPhi = 256);
+      ~GridCorrelator() {};
+
+      // interface
+      void Fill(const float* y, const float* phi, const float* w, const std::size_t nPar, Hist1D& hist);
+
+      // getters
+      double      GetCellY() const {return m_cellY;}
+      std::size_t GetNPhi() const {return m_nPhi;}
+      double      GetMaxError() const;
+
+    private:
+
+      // members
+      double                            m_cellY;
+      std::size_t                       m_nPhi;
+      FFT                               m_fftPhi;
+      FFT                               m_fftY;
+      std::vector<double>               m_dPhi2;
+      std::vector<std::complex<double>> m_grid;
+      std::vector<std::complex<double>> m_column;
+      std::vector<std::complex<double>> m_mirror;
+      std::vector<double>               m_bins;
+      std::vector<double>               m_bins2;
+
+  };  // end GridCorrelator
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,251 @@
+// ============================================================================
+//! \file   GridMatcher.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Angular (delta-R) matching of reconstructed to
+//! generated particles using a uniform grid in
+//! (pseudorapidity, phi).
+// ============================================================================
+
+#include "GridMatcher.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+
+
+
+namespace {
+
+  constexpr float Pi    = 3.14159265358979f;
+  constexpr float TwoPi = 2.f * Pi;
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  GridMatcher::GridMatcher(const GridMatcherOptions& opt) : m_opt(opt) {
+
+    // finest possible phi binning: cells exactly
+    // maxDeltaR wide
+    m_nPhiMax = std::max(1u, static_cast<uint32_t>(TwoPi / m_opt.maxDeltaR));
+
+  }  // end ctor(GridMatcherOptions&)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Match reconstructed particles of an event to generated ones
+  // --------------------------------------------------------------------------
+  //! On return recToGen[i] is the index of the gen
+  //! particle closest to rec particle i which passes
+  //! the delta-R (and energy) cuts, or -1.
+  //!
+  //! If exclusive, rec particles propose to their
+  //! closest gen particle, which keeps the closest
+  //! proposer; displaced rec particles propose again
+  //! to the next closest gen particle that would
+  //! take them. Since a gen particle's owner only
+  //! ever gets closer, this ends after a few rounds
+  //! with pairs taken closest first.
+  void GridMatcher::Match(
+    const ParticleView& rec,
+    const ParticleView& gen,
+    std::vector<int32_t>& recToGen
+  ) {
+
+    recToGen.assign(rec.size, -1);
+    if ((rec.size == 0) || (gen.size == 0)) return;
+
+    Locate(rec, m_recEta, m_recPhi);
+    Locate(gen, m_genEta, m_genPhi);
+    MakeGrid(gen.size);
+
+    // counting sort gen particles into cells
+    const std::size_t nCells = static_cast<std::size_t>(m_nEta) * m_nPhi;
+    m_cellStart.assign(nCells + 1, 0);
+    m_cellItems.resize(gen.size);
+    for (std::size_t iGen = 0; iGen < gen.size; ++iGen) {
+      ++m_cellStart[EtaCell(m_genEta[iGen]) * m_nPhi + PhiCell(m_genPhi[iGen]) + 1];
+    }
+    for (std::size_t iCell = 0; iCell < nCells; ++iCell) {
+      m_cellStart[iCell + 1] += m_cellStart[iCell];
+    }
+    m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (std::size_t iGen = 0; iGen < gen.size; ++iGen) {
+      m_cellItems[m_cursor[EtaCell(m_genEta[iGen]) * m_nPhi + PhiCell(m_genPhi[iGen])]++] = iGen;
+    }
+
+    // n.b. with an empty owner table, every gen
+    // particle takes any proposal
+    const float maxDR2 = m_opt.maxDeltaR * m_opt.maxDeltaR;
+    m_bestDR2.assign(gen.size, maxDR2);
+    m_owner.assign(gen.size, -1);
+
+    m_pending.resize(rec.size);
+    for (std::size_t iRec = 0; iRec < rec.size; ++iRec) {
+      m_pending[iRec] = iRec;
+    }
+    while (!m_pending.empty()) {
+      m_displaced.clear();
+      for (const uint32_t iRec : m_pending) {
+        float         dR2   = maxDR2;
+        const int32_t match = Nearest(iRec, rec, gen, dR2);
+        if (match < 0) continue;
+
+        recToGen[iRec] = match;
+        if (!m_opt.exclusive) continue;
+
+        if (m_owner[match] >= 0) {
+          recToGen[m_owner[match]] = -1;
+          m_displaced.push_back(m_owner[match]);
+        }
+        m_bestDR2[match] = dR2;
+        m_owner[match]   = iRec;
+      }
+      m_pending.swap(m_displaced);
+    }
+
+  }  // end 'Match(ParticleView&, ParticleView&, std::vector<int32_t>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Find the closest gen particle a rec particle can take
+  // --------------------------------------------------------------------------
+  //! Searches the 3x3 block of cells around the rec
+  //! particle for the closest gen particle passing
+  //! the cuts which is, if exclusive, closer than
+  //! its current owner. Returns its index and sets
+  //! dR2, or returns -1.
+  int32_t GridMatcher::Nearest(
+    const std::size_t iRec,
+    const ParticleView& rec,
+    const ParticleView& gen,
+    float& dR2
+  ) const {
+
+    // phi neighbours wrap around, but with fewer
+    // than 3 phi cells every cell is a neighbour
+    const int phiReach = (m_nPhi < 3) ? 0 : 1;
+    const int etaCell  = EtaCell(m_recEta[iRec]);
+    const int phiCell  = PhiCell(m_recPhi[iRec]);
+    float     best     = dR2;
+    int32_t   match    = -1;
+
+    for (int iEta = std::max(0, etaCell - 1); iEta <= std::min<int>(m_nEta - 1, etaCell + 1); ++iEta) {
+      for (int dPhi = -phiReach; dPhi <= phiReach; ++dPhi) {
+        for (uint32_t wrapped = 0; wrapped < ((phiReach == 0) ? m_nPhi : 1); ++wrapped) {
+
+          const uint32_t iPhi  = (phiReach == 0) ? wrapped : (phiCell + dPhi + m_nPhi) % m_nPhi;
+          const uint32_t iCell = iEta * m_nPhi + iPhi;
+          for (uint32_t iItem = m_cellStart[iCell]; iItem < m_cellStart[iCell + 1]; ++iItem) {
+
+            const uint32_t iGen = m_cellItems[iItem];
+            const float    dEta = m_recEta[iRec] - m_genEta[iGen];
+            float          dPh  = std::fabs(m_recPhi[iRec] - m_genPhi[iGen]);
+            if (dPh > Pi) dPh = TwoPi - dPh;
+
+            const float distance = (dEta * dEta) + (dPh * dPh);
+            if (distance >= best) continue;
+            if (m_opt.exclusive && (distance >= m_bestDR2[iGen])) continue;
+            if ((m_opt.maxRelDE >= 0.) && (std::fabs(rec.energy[iRec] - gen.energy[iGen]) > m_opt.maxRelDE * gen.energy[iGen])) {
+              continue;
+            }
+            best  = distance;
+            match = iGen;
+          }
+        }
+      }
+    }
+    dR2 = best;
+    return match;
+
+  }  // end 'Nearest(std::size_t, ParticleView&, ParticleView&, float&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Choose grid for an event
+  // --------------------------------------------------------------------------
+  //! Spans the eta range of the event's gen particles
+  //! (rec particles outside it fall into the edge
+  //! cells), and coarsens the finest grid over it so
+  //! that there are about as many cells as gen
+  //! particles, which keeps resetting the grid
+  //! O(N_gen). Cells only get larger than maxDeltaR,
+  //! so the 3x3 search stays exact. Needs the gen
+  //! particles located first.
+  void GridMatcher::MakeGrid(const std::size_t nGen) {
+
+    const auto  range = std::minmax_element(m_genEta.begin(), m_genEta.begin() + nGen);
+    const float span  = *range.second - *range.first;
+
+    const uint32_t nEtaFine = std::max(1u, static_cast<uint32_t>(span / m_opt.maxDeltaR));
+    const double   nFine    = static_cast<double>(nEtaFine) * m_nPhiMax;
+    const double   scale    = std::min(1., std::sqrt(static_cast<double>(nGen) / nFine));
+
+    // n.b. if eta is left with few cells, phi takes
+    // up the rest
+    m_nEta     = std::max(1u, static_cast<uint32_t>(nEtaFine * scale));
+    m_nPhi     = std::min<uint32_t>(m_nPhiMax, std::max<uint32_t>(1u, std::max<double>(m_nPhiMax * scale, nGen / m_nEta)));
+    m_etaMin   = *range.first;
+    m_etaWidth = std::max(m_opt.maxDeltaR, span / m_nEta);
+    m_phiWidth = TwoPi / m_nPhi;
+
+  }  // end 'MakeGrid(std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Calculate pseudorapidity and phi of particles
+  // --------------------------------------------------------------------------
+  void GridMatcher::Locate(
+    const ParticleView& pars,
+    std::vector<float>& eta,
+    std::vector<float>& phi
+  ) const {
+
+    eta.resize(pars.size);
+    phi.resize(pars.size);
+    for (std::size_t iPar = 0; iPar < pars.size; ++iPar) {
+      const float pt = std::hypot(pars.px[iPar], pars.py[iPar]);
+      eta[iPar] = (pt > 0.f) ? std::asinh(pars.pz[iPar] / pt) : std::copysign(m_opt.maxEta, pars.pz[iPar]);
+      phi[iPar] = std::atan2(pars.py[iPar], pars.px[iPar]);
+    }
+
+  }  // end 'Locate(ParticleView&, std::vector<float>&, std::vector<float>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get eta cell, clamping to the edge cells
+  // --------------------------------------------------------------------------
+  uint32_t GridMatcher::EtaCell(const float eta) const {
+
+    const float cell = std::floor((eta - m_etaMin) / m_etaWidth);
+    return static_cast<uint32_t>(std::clamp(cell, 0.f, static_cast<float>(m_nEta - 1)));
+
+  }  // end 'EtaCell(float)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get phi cell
+  // --------------------------------------------------------------------------
+  uint32_t GridMatcher::PhiCell(const float phi) const {
+
+    const uint32_t cell = static_cast<uint32_t>((phi + Pi) / m_phiWidth);
+    return std::min(cell, m_nPhi - 1);
+
+  }  // end 'PhiCell(float)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
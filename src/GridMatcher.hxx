@@ -0,0 +1,101 @@
+// ============================================================================
+//! \file   GridMatcher.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Angular (delta-R) matching of reconstructed to
+//! generated particles using a uniform grid in
+//! (pseudorapidity, phi).
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_GridMatcher_hxx
+#define EPNucleonEnergyCorrelator_GridMatcher_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Grid matcher options
+  // ==========================================================================
+  struct GridMatcherOptions {
+    float maxDeltaR   = 0.05;  //!< max sqrt(deta^2 + dphi^2) for a match
+    float maxRelDE    = -1.;   //!< max |E_rec - E_gen| / E_gen (negative = no cut)
+    float maxEta      = 10.;   //!< |eta| given to particles along the beam (pT = 0)
+    bool  exclusive   = true;  //!< if true, a gen particle is matched to at most one rec particle
+  };
+
+
+
+  // ==========================================================================
+  //! Grid-based delta-R matcher
+  // --------------------------------------------------------------------------
+  //! Generated particles are counting-sorted into
+  //! cells no smaller than maxDeltaR, so each rec
+  //! particle only needs to look at the 3x3 block of
+  //! cells around it. The grid spans the eta range
+  //! the event's gen particles actually cover, and
+  //! the no. of cells is scaled with N_gen (cells
+  //! are only ever made larger), so the cost per
+  //! event is about O(N_rec + N_gen) instead of
+  //! O(N_rec x N_gen), collimated events included.
+  //! Buffers are reused between events, so one
+  //! matcher should be kept per thread.
+  // ==========================================================================
+  class GridMatcher {
+
+    public:
+
+      // ctor/dtor
+      GridMatcher(const GridMatcherOptions& opt = GridMatcherOptions());
+      ~GridMatcher() {};
+
+      // interface
+      void Match(const ParticleView& rec, const ParticleView& gen, std::vector<int32_t>& recToGen);
+
+    private:
+
+      // helper methods
+      void     MakeGrid(const std::size_t nGen);
+      int32_t  Nearest(const std::size_t iRec, const ParticleView& rec, const ParticleView& gen, float& dR2) const;
+      void     Locate(const ParticleView& pars, std::vector<float>& eta, std::vector<float>& phi) const;
+      uint32_t EtaCell(const float eta) const;
+      uint32_t PhiCell(const float phi) const;
+
+      // members
+      GridMatcherOptions m_opt;
+      uint32_t           m_nPhiMax;
+
+      // current grid
+      uint32_t m_nEta     = 1;
+      uint32_t m_nPhi     = 1;
+      float    m_etaMin   = 0.;
+      float    m_etaWidth = 1.;
+      float    m_phiWidth = 1.;
+
+      // per-event buffers
+      std::vector<float>    m_recEta;
+      std::vector<float>    m_recPhi;
+      std::vector<float>    m_genEta;
+      std::vector<float>    m_genPhi;
+      std::vector<uint32_t> m_cellStart;
+      std::vector<uint32_t> m_cellItems;
+      std::vector<uint32_t> m_cursor;
+      std::vector<float>    m_bestDR2;
+      std::vector<int32_t>  m_owner;
+      std::vector<uint32_t> m_pending;
+      std::vector<uint32_t> m_displaced;
+
+  };  // end GridMatcher
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
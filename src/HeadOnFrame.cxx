@@ -0,0 +1,168 @@
+// ============================================================================
+//! \file   HeadOnFrame.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Correction of lab-frame momenta for the beam
+//! crossing angle, from the beam four-momenta.
+// ============================================================================
+
+#include "HeadOnFrame.hxx"
+
+// c++ utilities
+#include <cmath>
+
+
+
+namespace {
+
+  // boost into the rest frame of something moving
+  // with velocity (bx, by, bz)
+  bool makeBoost(const double bx, const double by, const double bz, double boost[4][4]) {
+
+    const double beta2 = bx * bx + by * by + bz * bz;
+    if (!(beta2 < 1.)) return false;
+
+    const double gamma   = 1. / std::sqrt(1. - beta2);
+    const double beta[3] = {bx, by, bz};
+
+    boost[0][0] = gamma;
+    for (int i = 0; i < 3; ++i) {
+      boost[0][i + 1] = -gamma * beta[i];
+      boost[i + 1][0] = -gamma * beta[i];
+      for (int j = 0; j < 3; ++j) {
+        const double delta = (i == j) ? 1. : 0.;
+        boost[i + 1][j + 1] = delta + ((beta2 > 0.) ? (gamma - 1.) * beta[i] * beta[j] / beta2 : 0.);
+      }
+    }
+    return true;
+  }
+
+  // out = a x b
+  void multiply(const double a[4][4], const double b[4][4], double out[4][4]) {
+    double product[4][4];
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        product[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        out[i][j] = product[i][j];
+      }
+    }
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Build transformation from the beams
+  // --------------------------------------------------------------------------
+  //! Returns false (and leaves the frame unbuilt) if
+  //! the beams have no center of mass frame.
+  bool HeadOnFrame::Build(const FourVector& eBeam, const FourVector& hBeam) {
+
+    m_built = false;
+
+    // boost: center of mass of the beams
+    const FourVector cm = eBeam + hBeam;
+    if (!(cm.e > 0.)) return false;
+
+    double toCM[4][4];
+    if (!makeBoost(cm.px / cm.e, cm.py / cm.e, cm.pz / cm.e, toCM)) return false;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        m_lambda[i][j] = toCM[i][j];
+      }
+    }
+
+    // rotation about y: hadron beam to px = 0
+    const FourVector hCM = Transform(hBeam);
+    const double     ry  = -std::atan2(hCM.px, hCM.pz);
+    const double     rotY[4][4] = {
+      {1., 0.,            0., 0.},
+      {0., std::cos(ry),  0., std::sin(ry)},
+      {0., 0.,            1., 0.},
+      {0., -std::sin(ry), 0., std::cos(ry)}
+    };
+    multiply(rotY, m_lambda, m_lambda);
+
+    // rotation about x: hadron beam to py = 0
+    const FourVector hY = Transform(hBeam);
+    const double     rx = std::atan2(hY.py, hY.pz);
+    const double     rotX[4][4] = {
+      {1., 0., 0.,           0.},
+      {0., 1., 0.,           0.},
+      {0., 0., std::cos(rx), -std::sin(rx)},
+      {0., 0., std::sin(rx), std::cos(rx)}
+    };
+    multiply(rotX, m_lambda, m_lambda);
+
+    // boost back along z, so the beams keep about
+    // their lab energies
+    double back[4][4];
+    if (!makeBoost(0., 0., -cm.pz / cm.e, back)) return false;
+    multiply(back, m_lambda, m_lambda);
+
+    m_built = true;
+    return true;
+
+  }  // end 'Build(FourVector&, FourVector&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Transform a four-vector into the head-on frame
+  // --------------------------------------------------------------------------
+  FourVector HeadOnFrame::Transform(const FourVector& p) const {
+
+    const double in[4] = {p.e, p.px, p.py, p.pz};
+    double       out[4];
+    for (int i = 0; i < 4; ++i) {
+      out[i] = m_lambda[i][0] * in[0] + m_lambda[i][1] * in[1] + m_lambda[i][2] * in[2] + m_lambda[i][3] * in[3];
+    }
+    return {out[0], out[1], out[2], out[3]};
+
+  }  // end 'Transform(FourVector&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Transform particles [first, Size()) of columns in place
+  // --------------------------------------------------------------------------
+  //! One pass over the whole stream, regardless of
+  //! event boundaries: the matrix is held in float
+  //! locals and each particle is independent, so
+  //! the loop vectorizes.
+  void HeadOnFrame::Apply(ParticleColumns& pars, const std::size_t first) const {
+
+    const float l00 = m_lambda[0][0], l01 = m_lambda[0][1], l02 = m_lambda[0][2], l03 = m_lambda[0][3];
+    const float l10 = m_lambda[1][0], l11 = m_lambda[1][1], l12 = m_lambda[1][2], l13 = m_lambda[1][3];
+    const float l20 = m_lambda[2][0], l21 = m_lambda[2][1], l22 = m_lambda[2][2], l23 = m_lambda[2][3];
+    const float l30 = m_lambda[3][0], l31 = m_lambda[3][1], l32 = m_lambda[3][2], l33 = m_lambda[3][3];
+
+    float*            energy = pars.energy.data();
+    float*            px     = pars.px.data();
+    float*            py     = pars.py.data();
+    float*            pz     = pars.pz.data();
+    const std::size_t size   = pars.Size();
+    for (std::size_t iPar = first; iPar < size; ++iPar) {
+      const float e = energy[iPar];
+      const float x = px[iPar];
+      const float y = py[iPar];
+      const float z = pz[iPar];
+      energy[iPar] = l00 * e + l01 * x + l02 * y + l03 * z;
+      px[iPar]     = l10 * e + l11 * x + l12 * y + l13 * z;
+      py[iPar]     = l20 * e + l21 * x + l22 * y + l23 * z;
+      pz[iPar]     = l30 * e + l31 * x + l32 * y + l33 * z;
+    }
+
+  }  // end 'Apply(ParticleColumns&, std::size_t)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
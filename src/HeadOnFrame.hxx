@@ -0,0 +1,66 @@
+// ============================================================================
+//! \file   HeadOnFrame.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Correction of lab-frame momenta for the beam
+//! crossing angle, from the beam four-momenta.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_HeadOnFrame_hxx
+#define EPNucleonEnergyCorrelator_HeadOnFrame_hxx
+
+// c++ utilities
+#include <cstddef>
+// package components
+#include "BreitFrame.hxx"
+#include "EventBatch.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Head-on frame
+  // --------------------------------------------------------------------------
+  //! Built from the electron and hadron beams: boosts
+  //! to their center of mass, rotates the hadron
+  //! beam onto +z (about y, then about x), and
+  //! boosts back along z by the z velocity of the
+  //! center of mass. The beams then collide head-on
+  //! along z with about their lab energies, so lab
+  //! angles aren't smeared by the crossing angle.
+  //!
+  //! The transformation only depends on the beams,
+  //! so it's built once per file and applied to
+  //! whole particle columns with Apply().
+  // ==========================================================================
+  class HeadOnFrame {
+
+    public:
+
+      // ctor/dtor
+      HeadOnFrame()  {};
+      ~HeadOnFrame() {};
+
+      // interface
+      bool       Build(const FourVector& eBeam, const FourVector& hBeam);
+      FourVector Transform(const FourVector& p) const;
+      void       Apply(ParticleColumns& pars, const std::size_t first = 0) const;
+
+      // getters
+      bool IsBuilt() const {return m_built;}
+
+    private:
+
+      // members
+      bool   m_built = false;
+      double m_lambda[4][4] = {{0.}};
+
+  };  // end HeadOnFrame
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,281 @@
+// ============================================================================
+//! \file   HepMCReader.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Readers for HepMC3 generator output, in ASCII
+//! and ROOT-tree form.
+// ============================================================================
+
+#include "HepMCReader.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+// posix utilities
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// hepmc libraries
+#ifdef EPNEC_USE_HEPMC3
+#include <HepMC3/GenEvent.h>
+#include <HepMC3/GenParticle.h>
+#include <HepMC3/ReaderRootTree.h>
+#endif
+// package components
+#include "Logger.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! ROOT-tree reader state
+  // --------------------------------------------------------------------------
+#ifdef EPNEC_USE_HEPMC3
+  struct HepMCRootReader::Impl {
+    std::unique_ptr<HepMC3::ReaderRootTree> reader;
+    HepMC3::GenEvent                        event;
+  };
+#else
+  struct HepMCRootReader::Impl {};
+#endif
+
+
+
+  // --------------------------------------------------------------------------
+  //! Map a file into memory
+  // --------------------------------------------------------------------------
+  bool HepMCAsciiReader::Open(const std::string& path) {
+
+    Close();
+    m_fd = ::open(path.data(), O_RDONLY);
+    if (m_fd < 0) {
+      EPNEC_LOG_WARNING("couldn't open HepMC3 file '%s'", path.data());
+      return false;
+    }
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0) {
+      Close();
+      return false;
+    }
+    m_size = info.st_size;
+    if (m_size == 0) return true;
+
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED) {
+      EPNEC_LOG_WARNING("couldn't map HepMC3 file '%s'", path.data());
+      Close();
+      return false;
+    }
+    ::madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(data);
+    Seek(0, m_size);
+    return true;
+
+  }  // end 'Open(std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Unmap and close the file
+  // --------------------------------------------------------------------------
+  void HepMCAsciiReader::Close() {
+
+    if (m_data) {
+      ::munmap(const_cast<char*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+    m_fd   = -1;
+    m_data = nullptr;
+    m_size = 0;
+    m_pos  = 0;
+    m_last = 0;
+
+  }  // end 'Close()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Restrict reading to events starting in [first, last)
+  // --------------------------------------------------------------------------
+  //! Moves to the first 'E' line at or after first,
+  //! skipping the header or the tail of an event
+  //! owned by the previous range.
+  void HepMCAsciiReader::Seek(const std::size_t first, const std::size_t last) {
+
+    m_last = std::min(last, m_size);
+    m_pos  = std::min(first, m_size);
+    if ((m_pos > 0) && (m_data[m_pos - 1] != '\n')) {
+      const void* eol = std::memchr(m_data + m_pos, '\n', m_size - m_pos);
+      m_pos = eol ? (static_cast<const char*>(eol) - m_data) + 1 : m_size;
+    }
+    while ((m_pos < m_size) && !AtEvent(m_pos)) {
+      const void* eol = std::memchr(m_data + m_pos, '\n', m_size - m_pos);
+      m_pos = eol ? (static_cast<const char*>(eol) - m_data) + 1 : m_size;
+    }
+
+  }  // end 'Seek(std::size_t, std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Parse the next event of the range
+  // --------------------------------------------------------------------------
+  //! Returns false once the next event starts past
+  //! the end of the range. Momenta are converted to
+  //! GeV if the event is in MeV.
+  bool HepMCAsciiReader::Next(HepMCEvent& event) {
+
+    event.Clear();
+    if ((m_pos >= m_last) || !AtEvent(m_pos)) return false;
+
+    // E <number> <no. of vertices> <no. of particles> ...
+    ReadLine();
+    event.number = std::strtoul(m_line.data() + 1, nullptr, 10);
+
+    double scale = 1.;
+    while ((m_pos < m_size) && !AtEvent(m_pos)) {
+      ReadLine();
+      if (m_line.size() < 2) continue;
+
+      // U <momentum unit> <length unit>
+      if (m_line[0] == 'U') {
+        scale = (m_line.compare(2, 3, "MEV") == 0) ? 1e-3 : 1.;
+      }
+
+      // P <id> <parent> <pdg> <px> <py> <pz> <e> <m> <status>
+      if (m_line[0] == 'P') {
+        char*         pos = const_cast<char*>(m_line.data()) + 1;
+        HepMCParticle par;
+        std::strtol(pos, &pos, 10);
+        std::strtol(pos, &pos, 10);
+        par.pdg    = std::strtol(pos, &pos, 10);
+        par.p.px   = std::strtod(pos, &pos) * scale;
+        par.p.py   = std::strtod(pos, &pos) * scale;
+        par.p.pz   = std::strtod(pos, &pos) * scale;
+        par.p.e    = std::strtod(pos, &pos) * scale;
+        std::strtod(pos, &pos);
+        par.status = std::strtol(pos, &pos, 10);
+        event.particles.push_back(par);
+      }
+    }
+    return true;
+
+  }  // end 'Next(HepMCEvent&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Copy the current line and move past it
+  // --------------------------------------------------------------------------
+  //! n.b. the copy gives the number parsers a null
+  //! terminator, which the mapped file doesn't have.
+  bool HepMCAsciiReader::ReadLine() {
+
+    if (m_pos >= m_size) return false;
+
+    const void*       eol = std::memchr(m_data + m_pos, '\n', m_size - m_pos);
+    const std::size_t end = eol ? static_cast<const char*>(eol) - m_data : m_size;
+    m_line.assign(m_data + m_pos, end - m_pos);
+    m_pos = eol ? end + 1 : m_size;
+    return true;
+
+  }  // end 'ReadLine()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Check if an event starts at a line
+  // --------------------------------------------------------------------------
+  bool HepMCAsciiReader::AtEvent(const std::size_t pos) const {
+
+    return (pos + 1 < m_size) && (m_data[pos] == 'E') && (m_data[pos + 1] == ' ');
+
+  }  // end 'AtEvent(std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  HepMCRootReader::HepMCRootReader() : m_impl(new Impl()) {
+
+    /* nothing to do */
+
+  }  // end ctor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  HepMCRootReader::~HepMCRootReader() {
+
+    /* nothing to do */
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Open a HepMC3 ROOT-tree file
+  // --------------------------------------------------------------------------
+  bool HepMCRootReader::Open(const std::string& path) {
+
+#ifdef EPNEC_USE_HEPMC3
+    m_impl->reader.reset(new HepMC3::ReaderRootTree(path));
+    if (m_impl->reader->failed()) {
+      EPNEC_LOG_WARNING("couldn't open HepMC3 file '%s'", path.data());
+      m_impl->reader.reset();
+      return false;
+    }
+    return true;
+#else
+    EPNEC_LOG_WARNING("built without HepMC3, can't read '%s'", path.data());
+    return false;
+#endif
+
+  }  // end 'Open(std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read the next event
+  // --------------------------------------------------------------------------
+  bool HepMCRootReader::Next(HepMCEvent& event) {
+
+    event.Clear();
+#ifdef EPNEC_USE_HEPMC3
+    if (!m_impl->reader) return false;
+    if (!m_impl->reader->read_event(m_impl->event) || m_impl->reader->failed()) {
+      return false;
+    }
+
+    HepMC3::GenEvent& gen = m_impl->event;
+    gen.set_units(HepMC3::Units::GEV, HepMC3::Units::MM);
+    event.number = gen.event_number();
+    for (const auto& particle : gen.particles()) {
+      const HepMC3::FourVector& p = particle->momentum();
+
+      HepMCParticle par;
+      par.pdg    = particle->pid();
+      par.status = particle->status();
+      par.p      = {p.e(), p.px(), p.py(), p.pz()};
+      event.particles.push_back(par);
+    }
+    return true;
+#else
+    return false;
+#endif
+
+  }  // end 'Next(HepMCEvent&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
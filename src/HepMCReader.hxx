@@ -0,0 +1,132 @@
+// ============================================================================
+//! \file   HepMCReader.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Readers for HepMC3 generator output, in ASCII
+//! and ROOT-tree form.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_HepMCReader_hxx
+#define EPNucleonEnergyCorrelator_HepMCReader_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+// package components
+#include "BreitFrame.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! One particle of a HepMC3 event
+  // ==========================================================================
+  struct HepMCParticle {
+    int32_t    pdg    = 0;  //!< pdg code
+    int32_t    status = 0;  //!< generator status (1 = final state, 4 = beam)
+    FourVector p;           //!< four-momentum in GeV
+  };
+
+
+
+  // ==========================================================================
+  //! One HepMC3 event
+  // --------------------------------------------------------------------------
+  //! Only the particles are kept; vertices and
+  //! attributes aren't needed for the Breit frame.
+  // ==========================================================================
+  struct HepMCEvent {
+    uint32_t                   number = 0;  //!< event number
+    std::vector<HepMCParticle> particles;   //!< all particles, momenta in GeV
+
+    void Clear() {
+      number = 0;
+      particles.clear();
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! Memory-mapped HepMC3 ASCII reader
+  // --------------------------------------------------------------------------
+  //! Maps the whole file and parses events in
+  //! place. A byte range [first, last) of the file
+  //! owns every event whose 'E' line starts inside
+  //! it, so a file can be cut at arbitrary offsets
+  //! and each piece parsed on its own thread
+  //! without any event being read twice or missed.
+  // ==========================================================================
+  class HepMCAsciiReader {
+
+    public:
+
+      // ctor/dtor
+      HepMCAsciiReader()  {};
+      ~HepMCAsciiReader() {Close();}
+
+      // interface
+      bool Open(const std::string& path);
+      void Close();
+      void Seek(const std::size_t first, const std::size_t last);
+      bool Next(HepMCEvent& event);
+
+      // getters
+      std::size_t Size() const {return m_size;}
+
+    private:
+
+      // helper methods
+      bool ReadLine();
+      bool AtEvent(const std::size_t pos) const;
+
+      // members
+      int         m_fd   = -1;
+      const char* m_data = nullptr;
+      std::size_t m_size = 0;
+      std::size_t m_pos  = 0;
+      std::size_t m_last = 0;
+      std::string m_line;
+
+  };  // end HepMCAsciiReader
+
+
+
+  // ==========================================================================
+  //! HepMC3 ROOT-tree reader
+  // --------------------------------------------------------------------------
+  //! Wraps HepMC3::ReaderRootTree, so it's only
+  //! available when built with HepMC3. Files are
+  //! read sequentially.
+  // ==========================================================================
+  class HepMCRootReader {
+
+    public:
+
+      // ctor/dtor
+      HepMCRootReader();
+      ~HepMCRootReader();
+
+      // interface
+      bool Open(const std::string& path);
+      bool Next(HepMCEvent& event);
+
+    private:
+
+      // n.b. defined with or without HepMC3
+      struct Impl;
+
+      // members
+      std::unique_ptr<Impl> m_impl;
+
+  };  // end HepMCRootReader
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
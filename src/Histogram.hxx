@@ -0,0 +1,380 @@
+// ============================================================================
+//! \file   Histogram.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Lightweight histograms used as thread-local
+//! accumulators; converted to ROOT histograms only
+//! when written out.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Histogram_hxx
+#define EPNucleonEnergyCorrelator_Histogram_hxx
+
+// c++ utilities
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Histogram axis
+  // ==========================================================================
+  struct Axis {
+    std::string title;  //!< title of axis
+    std::size_t num;    //!< no. of bins
+    double      start;  //!< low edge of bin 1
+    double      stop;   //!< low edge of bin num+1
+
+    // find bin of a value, 0 = underflow and num+1 = overflow
+    std::size_t Find(const double x) const {
+      if (!(x >= start)) return 0;
+      if (x >= stop) return num + 1;
+      const std::size_t bin = 1 + static_cast<std::size_t>((x - start) / (stop - start) * num);
+      return (bin > num) ? num : bin;
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! Sampled cost of filling a histogram
+  // --------------------------------------------------------------------------
+  //! One fill in every period is timed, and the
+  //! cost of all fills is estimated from the mean
+  //! of the timed ones. Each thread's copy of a
+  //! histogram keeps its own samples; they aren't
+  //! merged with the bins.
+  // ==========================================================================
+  struct FillCost {
+    uint32_t period    = 0;   //!< time one fill in this many (0 = off)
+    uint32_t countdown = 0;   //!< no. of fills until the next timed one
+    uint64_t nSampled  = 0;   //!< no. of timed fills
+    double   seconds   = 0.;  //!< total time of timed fills
+
+    void SetPeriod(const uint32_t every) {
+      period    = every;
+      countdown = every;
+    }
+
+    // check if the next fill should be timed
+    bool Due() {
+      if ((period == 0) || (--countdown > 0)) return false;
+      countdown = period;
+      return true;
+    }
+
+    // add a timed fill which started at start
+    void Record(const std::chrono::steady_clock::time_point start) {
+      const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+      seconds += took.count();
+      ++nSampled;
+    }
+  };
+
+
+
+  // ==========================================================================
+  //! 1D histogram
+  // --------------------------------------------------------------------------
+  //! Keeps sum of weights and sum of squared weights
+  //! per bin, with ROOT's bin numbering (0 and
+  //! num+1 are under/overflow).
+  // ==========================================================================
+  class Hist1D {
+
+    public:
+
+      // ctor/dtor
+      Hist1D() {};
+      Hist1D(const std::string& name, const std::string& title, const Axis& x) :
+        m_name(name),
+        m_title(title),
+        m_x(x),
+        m_sumw(x.num + 2, 0.),
+        m_sumw2(x.num + 2, 0.) {};
+      ~Hist1D() {};
+
+      // fill a (global) bin
+      void FillBin(const std::size_t bin, const double w = 1.) {
+        if (m_cost.Due()) {
+          const auto start = std::chrono::steady_clock::now();
+          Add(bin, w);
+          m_cost.Record(start);
+        } else {
+          Add(bin, w);
+        }
+      }
+
+      // fill a value
+      void Fill(const double x, const double w = 1.) {
+        if (m_cost.Due()) {
+          const auto start = std::chrono::steady_clock::now();
+          Add(m_x.Find(x), w);
+          m_cost.Record(start);
+        } else {
+          Add(m_x.Find(x), w);
+        }
+      }
+
+      // add (global) bins [first, last) of another
+      // histogram with the same binning
+      void MergeBins(const Hist1D& other, const std::size_t first, const std::size_t last) {
+        for (std::size_t bin = first; bin < last; ++bin) {
+          m_sumw[bin]  += other.m_sumw[bin];
+          m_sumw2[bin] += other.m_sumw2[bin];
+        }
+      }
+
+      // add another histogram with the same binning
+      void Merge(const Hist1D& other) {
+        MergeBins(other, 0, m_sumw.size());
+        m_entries += other.m_entries;
+      }
+
+      // set contents of a (global) bin
+      void SetBin(const std::size_t bin, const double sumw, const double sumw2) {
+        m_sumw[bin]  = sumw;
+        m_sumw2[bin] = sumw2;
+      }
+
+      // add to contents of a (global) bin, e.g. fills
+      // summed elsewhere; entries are left as they are
+      void AddBin(const std::size_t bin, const double sumw, const double sumw2) {
+        m_sumw[bin]  += sumw;
+        m_sumw2[bin] += sumw2;
+      }
+
+      // setters
+      void SetName(const std::string& name) {m_name = name;}
+      void SetEntries(const double entries) {m_entries = entries;}
+      void SetCostPeriod(const uint32_t period) {m_cost.SetPeriod(period);}
+
+      // reset all bins
+      void Reset() {
+        m_sumw.assign(m_sumw.size(), 0.);
+        m_sumw2.assign(m_sumw2.size(), 0.);
+        m_entries = 0.;
+      }
+
+      // getters
+      const std::string&         GetName() const {return m_name;}
+      const std::string&         GetTitle() const {return m_title;}
+      const Axis&                GetX() const {return m_x;}
+      const std::vector<double>& GetSumW() const {return m_sumw;}
+      const std::vector<double>& GetSumW2() const {return m_sumw2;}
+      double                     GetEntries() const {return m_entries;}
+      const FillCost&            GetCost() const {return m_cost;}
+
+    private:
+
+      // add a weight to a (global) bin
+      void Add(const std::size_t bin, const double w) {
+        m_sumw[bin]  += w;
+        m_sumw2[bin] += w * w;
+        ++m_entries;
+      }
+
+      // members
+      std::string         m_name;
+      std::string         m_title;
+      Axis                m_x;
+      std::vector<double> m_sumw;
+      std::vector<double> m_sumw2;
+      double              m_entries = 0.;
+      FillCost            m_cost;
+
+  };  // end Hist1D
+
+
+
+  // ==========================================================================
+  //! 2D histogram
+  // --------------------------------------------------------------------------
+  //! Bins are stored row-major in x, i.e. global bin
+  //! = xbin + (nx + 2) * ybin like ROOT.
+  // ==========================================================================
+  class Hist2D {
+
+    public:
+
+      // ctor/dtor
+      Hist2D() {};
+      Hist2D(const std::string& name, const std::string& title, const Axis& x, const Axis& y) :
+        m_name(name),
+        m_title(title),
+        m_x(x),
+        m_y(y),
+        m_sumw((x.num + 2) * (y.num + 2), 0.),
+        m_sumw2((x.num + 2) * (y.num + 2), 0.) {};
+      ~Hist2D() {};
+
+      // find global bin of a pair of values
+      std::size_t FindBin(const double x, const double y) const {
+        return m_x.Find(x) + (m_x.num + 2) * m_y.Find(y);
+      }
+
+      // fill a global bin
+      void FillBin(const std::size_t bin, const double w = 1.) {
+        if (m_cost.Due()) {
+          const auto start = std::chrono::steady_clock::now();
+          Add(bin, w);
+          m_cost.Record(start);
+        } else {
+          Add(bin, w);
+        }
+      }
+
+      // fill a pair of values
+      void Fill(const double x, const double y, const double w = 1.) {
+        if (m_cost.Due()) {
+          const auto start = std::chrono::steady_clock::now();
+          Add(FindBin(x, y), w);
+          m_cost.Record(start);
+        } else {
+          Add(FindBin(x, y), w);
+        }
+      }
+
+      // add (global) bins [first, last) of another
+      // histogram with the same binning
+      void MergeBins(const Hist2D& other, const std::size_t first, const std::size_t last) {
+        for (std::size_t bin = first; bin < last; ++bin) {
+          m_sumw[bin]  += other.m_sumw[bin];
+          m_sumw2[bin] += other.m_sumw2[bin];
+        }
+      }
+
+      // add another histogram with the same binning
+      void Merge(const Hist2D& other) {
+        MergeBins(other, 0, m_sumw.size());
+        m_entries += other.m_entries;
+      }
+
+      // set contents of a (global) bin
+      void SetBin(const std::size_t bin, const double sumw, const double sumw2) {
+        m_sumw[bin]  = sumw;
+        m_sumw2[bin] = sumw2;
+      }
+
+      // setters
+      void SetName(const std::string& name) {m_name = name;}
+      void SetEntries(const double entries) {m_entries = entries;}
+      void SetCostPeriod(const uint32_t period) {m_cost.SetPeriod(period);}
+
+      // reset all bins
+      void Reset() {
+        m_sumw.assign(m_sumw.size(), 0.);
+        m_sumw2.assign(m_sumw2.size(), 0.);
+        m_entries = 0.;
+      }
+
+      // getters
+      const std::string&         GetName() const {return m_name;}
+      const std::string&         GetTitle() const {return m_title;}
+      const Axis&                GetX() const {return m_x;}
+      const Axis&                GetY() const {return m_y;}
+      const std::vector<double>& GetSumW() const {return m_sumw;}
+      const std::vector<double>& GetSumW2() const {return m_sumw2;}
+      double                     GetEntries() const {return m_entries;}
+      const FillCost&            GetCost() const {return m_cost;}
+
+    private:
+
+      // add a weight to a (global) bin
+      void Add(const std::size_t bin, const double w) {
+        m_sumw[bin]  += w;
+        m_sumw2[bin] += w * w;
+        ++m_entries;
+      }
+
+      // members
+      std::string         m_name;
+      std::string         m_title;
+      Axis                m_x;
+      Axis                m_y;
+      std::vector<double> m_sumw;
+      std::vector<double> m_sumw2;
+      double              m_entries = 0.;
+      FillCost            m_cost;
+
+  };  // end Hist2D
+
+
+
+  // ==========================================================================
+  //! Set of booked histograms
+  // --------------------------------------------------------------------------
+  //! One set is kept per thread. Histograms are
+  //! booked once into a template set, copied to each
+  //! thread, filled by index and merged at the end.
+  // ==========================================================================
+  struct HistogramSet {
+    std::vector<Hist1D> h1;  //!< 1d histograms
+    std::vector<Hist2D> h2;  //!< 2d histograms
+
+    std::size_t Book(const Hist1D& hist) {
+      h1.push_back(hist);
+      return h1.size() - 1;
+    }
+
+    std::size_t Book(const Hist2D& hist) {
+      h2.push_back(hist);
+      return h2.size() - 1;
+    }
+
+    void SetCostPeriod(const uint32_t period) {
+      for (auto& hist : h1) {
+        hist.SetCostPeriod(period);
+      }
+      for (auto& hist : h2) {
+        hist.SetCostPeriod(period);
+      }
+    }
+
+    void Merge(const HistogramSet& other) {
+      for (std::size_t iHist = 0; iHist < h1.size(); ++iHist) {
+        h1[iHist].Merge(other.h1[iHist]);
+      }
+      for (std::size_t iHist = 0; iHist < h2.size(); ++iHist) {
+        h2[iHist].Merge(other.h2[iHist]);
+      }
+    }
+  };
+
+
+
+  // --------------------------------------------------------------------------
+  //! Bin-by-bin ratio of two histograms
+  // --------------------------------------------------------------------------
+  //! Returns scale * num / den with errors of
+  //! uncorrelated samples; bins where den is empty
+  //! are left at zero. Works for Hist1D and Hist2D.
+  template <typename Hist> Hist Divide(const Hist& num, const Hist& den, const std::string& name, const double scale = 1.) {
+
+    Hist ratio = num;
+    ratio.Reset();
+    ratio.SetName(name);
+    for (std::size_t bin = 0; bin < num.GetSumW().size(); ++bin) {
+      const double a = num.GetSumW()[bin];
+      const double b = den.GetSumW()[bin];
+      if ((a == 0.) || (b == 0.)) continue;
+
+      const double r    = scale * a / b;
+      const double err2 = r * r * (num.GetSumW2()[bin] / (a * a) + den.GetSumW2()[bin] / (b * b));
+      ratio.SetBin(bin, r, err2);
+    }
+    return ratio;
+
+  }  // end 'Divide(Hist&, Hist&, std::string&, double)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,83 @@
+// ============================================================================
+//! \file   HistogramWriter.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Writes sets of histograms to ROOT files.
+// ============================================================================
+
+#include "HistogramWriter.hxx"
+
+// root libraries
+#include <TFile.h>
+#include <TH1.h>
+#include <TH2.h>
+// c++ utilities
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+
+
+namespace {
+
+  using namespace EPNucleonEnergyCorrelator;
+
+  // convert to root histograms
+  std::unique_ptr<TH1D> toRoot(const Hist1D& hist) {
+    const Axis& x = hist.GetX();
+    std::unique_ptr<TH1D> root(new TH1D(hist.GetName().data(), hist.GetTitle().data(), x.num, x.start, x.stop));
+    root->SetDirectory(nullptr);
+    for (std::size_t bin = 0; bin < hist.GetSumW().size(); ++bin) {
+      root->SetBinContent(bin, hist.GetSumW()[bin]);
+      root->SetBinError(bin, std::sqrt(hist.GetSumW2()[bin]));
+    }
+    root->SetEntries(hist.GetEntries());
+    return root;
+  }
+
+  std::unique_ptr<TH2D> toRoot(const Hist2D& hist) {
+    const Axis& x = hist.GetX();
+    const Axis& y = hist.GetY();
+    std::unique_ptr<TH2D> root(new TH2D(hist.GetName().data(), hist.GetTitle().data(), x.num, x.start, x.stop, y.num, y.start, y.stop));
+    root->SetDirectory(nullptr);
+    for (std::size_t bin = 0; bin < hist.GetSumW().size(); ++bin) {
+      root->SetBinContent(bin, hist.GetSumW()[bin]);
+      root->SetBinError(bin, std::sqrt(hist.GetSumW2()[bin]));
+    }
+    root->SetEntries(hist.GetEntries());
+    return root;
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Write a set of histograms to a root file
+  // --------------------------------------------------------------------------
+  bool WriteHistograms(const HistogramSet& hists, const std::string& path) {
+
+    std::unique_ptr<TFile> output(new TFile(path.data(), "recreate"));
+    if (!output || output->IsZombie()) {
+      std::cerr << "PANIC: couldn't open output file '" << path << "'!" << std::endl;
+      return false;
+    }
+
+    output->cd();
+    for (const auto& hist : hists.h1) {
+      toRoot(hist)->Write();
+    }
+    for (const auto& hist : hists.h2) {
+      toRoot(hist)->Write();
+    }
+    output->Close();
+    return true;
+
+  }  // end 'WriteHistograms(HistogramSet&, std::string&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,34 @@
+// ============================================================================
+//! \file   HistogramWriter.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Writes sets of histograms to ROOT files.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_HistogramWriter_hxx
+#define EPNucleonEnergyCorrelator_HistogramWriter_hxx
+
+// c++ utilities
+#include <string>
+// package components
+#include "Histogram.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Write a set of histograms to a root file
+  // --------------------------------------------------------------------------
+  //! Histograms become TH1D/TH2D with the same
+  //! binning, contents and errors. Fits
+  //! Calculator::Writer, so it can be handed to
+  //! Calculator::SetWriter().
+  bool WriteHistograms(const HistogramSet& hists, const std::string& path);
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,273 @@
+// ============================================================================
+//! \file   Logger.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Asynchronous logger for diagnostics from worker
+//! threads.
+// ============================================================================
+
+#include "Logger.hxx"
+
+// c++ utilities
+#include <cstdarg>
+
+
+
+namespace {
+
+  // prefix of each level
+  const char* prefix(const EPNucleonEnergyCorrelator::LogLevel level) {
+    switch (level) {
+      case EPNucleonEnergyCorrelator::LogLevel::Debug:
+        return "DEBUG: ";
+      case EPNucleonEnergyCorrelator::LogLevel::Warning:
+        return "WARNING: ";
+      case EPNucleonEnergyCorrelator::LogLevel::Panic:
+        return "PANIC: ";
+      default:
+        return "";
+    }
+  }
+
+  // serializes writes while the logger isn't running
+  std::mutex FallbackLock;
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Check a record against the rate limit
+  // --------------------------------------------------------------------------
+  //! Counts are reset whenever a new one-second
+  //! window starts; a limit of 0 means unlimited.
+  bool LogSite::Allow(const int64_t now, const uint32_t perSecond) {
+
+    if (perSecond == 0) return true;
+
+    const int64_t window = now / 1000000000;
+    int64_t       last   = m_window.load(std::memory_order_relaxed);
+    if ((window != last) && m_window.compare_exchange_strong(last, window, std::memory_order_relaxed)) {
+      m_count.store(0, std::memory_order_relaxed);
+    }
+
+    if (m_count.fetch_add(1, std::memory_order_relaxed) < perSecond) {
+      return true;
+    }
+    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+
+  }  // end 'Allow(int64_t, uint32_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get the process-wide logger
+  // --------------------------------------------------------------------------
+  Logger& Logger::Get() {
+
+    static Logger logger;
+    return logger;
+
+  }  // end 'Get()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  Logger::~Logger() {
+
+    Stop();
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Start the writer thread
+  // --------------------------------------------------------------------------
+  //! Writes to the given file, or to stderr if no
+  //! path is given. Until this is called (and after
+  //! Stop()) records are written synchronously.
+  bool Logger::Start(const std::string& path) {
+
+    if (m_running) return true;
+
+    if (!path.empty()) {
+      m_file = std::fopen(path.data(), "w");
+      if (!m_file) {
+        m_file = stderr;
+        std::fprintf(stderr, "WARNING: couldn't open log '%s', logging to stderr\n", path.data());
+      }
+    }
+
+    m_stop   = false;
+    m_writer = std::thread([this]() {
+      while (!m_stop) {
+        if (Drain()) continue;
+        std::unique_lock<std::mutex> guard(m_sleepLock);
+        m_wake.wait_for(guard, std::chrono::milliseconds(10), [this]() {return m_stop.load();});
+      }
+    });
+    m_running = true;
+    return true;
+
+  }  // end 'Start(std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Drain all rings and stop the writer thread
+  // --------------------------------------------------------------------------
+  //! n.b. records pushed while this runs may be
+  //! lost, so stop workers first.
+  void Logger::Stop() {
+
+    if (!m_running) return;
+
+    {
+      std::lock_guard<std::mutex> guard(m_sleepLock);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+    m_running = false;
+
+    Drain();
+    if (m_dropped > 0) {
+      std::fprintf(m_file, "WARNING: %llu log records dropped on full buffers\n", static_cast<unsigned long long>(m_dropped.load()));
+    }
+    std::fflush(m_file);
+    if (m_file != stderr) {
+      std::fclose(m_file);
+      m_file = stderr;
+    }
+
+  }  // end 'Stop()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Format and queue a record
+  // --------------------------------------------------------------------------
+  //! Never blocks while the logger is running: a
+  //! record which doesn't fit in the thread's ring
+  //! is counted and dropped.
+  void Logger::Push(const LogLevel level, LogSite& site, const char* format, ...) {
+
+    const int64_t now = Now();
+    if (!site.Allow(now, m_perSecond)) return;
+
+    // pick slot: own ring if running, otherwise a
+    // local record written straight away
+    LogRecord local;
+    Ring*     ring = nullptr;
+    uint64_t  head = 0;
+    if (m_running) {
+      ring = Local();
+      head = ring->head.load(std::memory_order_relaxed);
+      if (head - ring->tail.load(std::memory_order_acquire) >= RingSize) {
+        ++m_dropped;
+        return;
+      }
+    }
+    LogRecord& record = ring ? ring->records[head & (RingSize - 1)] : local;
+
+    record.time       = now;
+    record.thread     = ring ? ring->thread : 0;
+    record.level      = level;
+    record.suppressed = site.TakeSuppressed();
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    if (ring) {
+      ring->head.store(head + 1, std::memory_order_release);
+    } else {
+      std::lock_guard<std::mutex> guard(FallbackLock);
+      Write(record);
+    }
+
+  }  // end 'Push(LogLevel, LogSite&, char*, ...)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get the ring of the calling thread
+  // --------------------------------------------------------------------------
+  //! Rings are created on a thread's first record and
+  //! kept until the logger is destroyed, so threads
+  //! may come and go.
+  Logger::Ring* Logger::Local() {
+
+    thread_local Ring* ring = nullptr;
+    if (!ring) {
+      std::lock_guard<std::mutex> guard(m_ringLock);
+      m_rings.emplace_back(new Ring());
+      ring         = m_rings.back().get();
+      ring->thread = m_rings.size() - 1;
+    }
+    return ring;
+
+  }  // end 'Local()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get time since start in ns
+  // --------------------------------------------------------------------------
+  int64_t Logger::Now() const {
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+
+  }  // end 'Now()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write out everything queued
+  // --------------------------------------------------------------------------
+  //! Returns true if anything was written.
+  bool Logger::Drain() {
+
+    bool wrote = false;
+
+    std::lock_guard<std::mutex> guard(m_ringLock);
+    for (auto& ring : m_rings) {
+      const uint64_t head = ring->head.load(std::memory_order_acquire);
+      uint64_t       tail = ring->tail.load(std::memory_order_relaxed);
+      for (; tail < head; ++tail) {
+        Write(ring->records[tail & (RingSize - 1)]);
+        wrote = true;
+      }
+      ring->tail.store(tail, std::memory_order_release);
+    }
+    if (wrote) std::fflush(m_file);
+    return wrote;
+
+  }  // end 'Drain()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write out a record
+  // --------------------------------------------------------------------------
+  void Logger::Write(const LogRecord& record) {
+
+    std::fprintf(m_file, "[%12.6f] [t%02u] %s%s", record.time * 1e-9, record.thread, prefix(record.level), record.text);
+    if (record.suppressed > 0) {
+      std::fprintf(m_file, " (%u similar records suppressed)", record.suppressed);
+    }
+    std::fputc('\n', m_file);
+
+  }  // end 'Write(LogRecord&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,196 @@
+// ============================================================================
+//! \file   Logger.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Asynchronous logger for diagnostics from worker
+//! threads.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Logger_hxx
+#define EPNucleonEnergyCorrelator_Logger_hxx
+
+// c++ utilities
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+// ----------------------------------------------------------------------------
+//! Lowest level compiled in
+// ----------------------------------------------------------------------------
+//! 0 = debug, 1 = info, 2 = warning, 3 = panic.
+//! Calls below this level compile to nothing.
+#ifndef EPNEC_LOG_LEVEL
+#define EPNEC_LOG_LEVEL 1
+#endif
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Log levels
+  // ==========================================================================
+  enum class LogLevel : uint8_t {
+    Debug   = 0,  //!< per-event/per-unit detail
+    Info    = 1,  //!< progress
+    Warning = 2,  //!< recoverable problems
+    Panic   = 3   //!< fatal problems
+  };
+
+
+
+  // ==========================================================================
+  //! A formatted log record
+  // ==========================================================================
+  struct LogRecord {
+    int64_t  time       = 0;                //!< ns since the logger started
+    uint32_t thread     = 0;                //!< index of producing thread
+    uint32_t suppressed = 0;                //!< no. of records dropped by the rate limit before this one
+    LogLevel level      = LogLevel::Info;   //!< level of record
+    char     text[236]  = {0};              //!< message, truncated if too long
+  };
+
+
+
+  // ==========================================================================
+  //! Rate limit of one logging call site
+  // --------------------------------------------------------------------------
+  //! Allows up to a given no. of records per second
+  //! and counts what it drops, so the next record
+  //! that gets through can report it.
+  // ==========================================================================
+  class LogSite {
+
+    public:
+
+      bool     Allow(const int64_t now, const uint32_t perSecond);
+      uint32_t TakeSuppressed() {return m_suppressed.exchange(0, std::memory_order_relaxed);}
+
+    private:
+
+      // members
+      std::atomic<int64_t>  m_window     {-1};
+      std::atomic<uint32_t> m_count      {0};
+      std::atomic<uint32_t> m_suppressed {0};
+
+  };  // end LogSite
+
+
+
+  // ==========================================================================
+  //! Asynchronous logger
+  // --------------------------------------------------------------------------
+  //! Each thread formats its records into its own
+  //! single-producer ring buffer, without locks; a
+  //! background thread drains the rings and writes
+  //! them out. If a ring is full the record is
+  //! dropped rather than blocking the producer. Use
+  //! through the EPNEC_LOG_* macros.
+  // ==========================================================================
+  class Logger {
+
+    public:
+
+      // the process-wide logger
+      static Logger& Get();
+
+      // interface
+      bool Start(const std::string& path = "");
+      void Stop();
+      void Push(const LogLevel level, LogSite& site, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+      ;
+
+      // setters
+      void SetRateLimit(const uint32_t perSecond) {m_perSecond = perSecond;}
+
+      // getters
+      uint64_t NDropped() const {return m_dropped;}
+
+    private:
+
+      // no. of records per ring (power of 2)
+      static constexpr std::size_t RingSize = 512;
+
+      // single-producer/single-consumer ring
+      struct Ring {
+        uint32_t              thread;
+        std::atomic<uint64_t> head {0};
+        std::atomic<uint64_t> tail {0};
+        LogRecord             records[RingSize];
+      };
+
+      // ctor/dtor
+      Logger() {};
+      ~Logger();
+
+      // helper methods
+      Ring*   Local();
+      int64_t Now() const;
+      bool    Drain();
+      void    Write(const LogRecord& record);
+
+      // members
+      std::vector<std::unique_ptr<Ring>>    m_rings;
+      std::mutex                            m_ringLock;
+      std::thread                           m_writer;
+      std::mutex                            m_sleepLock;
+      std::condition_variable               m_wake;
+      std::atomic<bool>                     m_running   {false};
+      std::atomic<bool>                     m_stop      {false};
+      std::atomic<uint64_t>                 m_dropped   {0};
+      std::atomic<uint32_t>                 m_perSecond {100};
+      std::FILE*                            m_file      = stderr;
+      std::chrono::steady_clock::time_point m_start     = std::chrono::steady_clock::now();
+
+  };  // end Logger
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+
+
+// ----------------------------------------------------------------------------
+//! Logging macros
+// ----------------------------------------------------------------------------
+//! Each call site has its own rate limit.
+#define EPNEC_LOG(level, ...)                                                        \
+  do {                                                                               \
+    static EPNucleonEnergyCorrelator::LogSite epnecLogSite;                          \
+    EPNucleonEnergyCorrelator::Logger::Get().Push(level, epnecLogSite, __VA_ARGS__); \
+  } while (0)
+
+#if EPNEC_LOG_LEVEL <= 0
+#define EPNEC_LOG_DEBUG(...) EPNEC_LOG(EPNucleonEnergyCorrelator::LogLevel::Debug, __VA_ARGS__)
+#else
+#define EPNEC_LOG_DEBUG(...) do {} while (0)
+#endif
+
+#if EPNEC_LOG_LEVEL <= 1
+#define EPNEC_LOG_INFO(...) EPNEC_LOG(EPNucleonEnergyCorrelator::LogLevel::Info, __VA_ARGS__)
+#else
+#define EPNEC_LOG_INFO(...) do {} while (0)
+#endif
+
+#if EPNEC_LOG_LEVEL <= 2
+#define EPNEC_LOG_WARNING(...) EPNEC_LOG(EPNucleonEnergyCorrelator::LogLevel::Warning, __VA_ARGS__)
+#else
+#define EPNEC_LOG_WARNING(...) do {} while (0)
+#endif
+
+#define EPNEC_LOG_PANIC(...) EPNEC_LOG(EPNucleonEnergyCorrelator::LogLevel::Panic, __VA_ARGS__)
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,86 @@
+// ============================================================================
+//! \file   Observable.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Interface for user observables, and loading
+//! them from plugin libraries.
+// ============================================================================
+
+#include "Observable.hxx"
+
+// c++ utilities
+#include <iostream>
+// posix utilities
+#include <dlfcn.h>
+
+
+
+namespace {
+
+  // symbols every plugin exports
+  using AbiFunction    = int (*)();
+  using CreateFunction = EPNucleonEnergyCorrelator::Observable* (*)();
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  //! n.b. the observable's code lives in the
+  //! library, so it has to go first.
+  ObservablePlugin::~ObservablePlugin() {
+
+    m_observable.reset();
+    if (m_handle) {
+      dlclose(m_handle);
+    }
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Load a plugin library and create its observable
+  // --------------------------------------------------------------------------
+  //! Plugins built against a different version of
+  //! the interface are refused rather than risking
+  //! a mismatched vtable.
+  bool ObservablePlugin::Load(const std::string& path) {
+
+    m_path   = path;
+    m_handle = dlopen(path.data(), RTLD_NOW | RTLD_LOCAL);
+    if (!m_handle) {
+      std::cerr << "PANIC: couldn't load plugin '" << path << "': " << dlerror() << std::endl;
+      return false;
+    }
+
+    AbiFunction    abi    = reinterpret_cast<AbiFunction>(dlsym(m_handle, "epnec_plugin_abi"));
+    CreateFunction create = reinterpret_cast<CreateFunction>(dlsym(m_handle, "epnec_create_observable"));
+    if (!abi || !create) {
+      std::cerr << "PANIC: '" << path << "' doesn't export an observable (see EPNEC_REGISTER_OBSERVABLE)!" << std::endl;
+      return false;
+    }
+    if (abi() != EPNEC_PLUGIN_ABI) {
+      std::cerr << "PANIC: plugin '" << path << "' was built against interface version " << abi()
+                << ", but this is version " << EPNEC_PLUGIN_ABI << "!" << std::endl;
+      return false;
+    }
+
+    m_observable.reset(create());
+    if (!m_observable) {
+      std::cerr << "PANIC: plugin '" << path << "' didn't create an observable!" << std::endl;
+      return false;
+    }
+    std::cout << "    Loaded observable '" << m_observable->Name() << "' from '" << path << "'" << std::endl;
+    return true;
+
+  }  // end 'Load(std::string&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,121 @@
+// ============================================================================
+//! \file   Observable.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Interface for user observables, and loading
+//! them from plugin libraries.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Observable_hxx
+#define EPNucleonEnergyCorrelator_Observable_hxx
+
+// c++ utilities
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+#include "EventShapes.hxx"
+#include "Histogram.hxx"
+
+// bump whenever Observable or ObservableSpan change,
+// or the layout of a type they hand to plugins
+// (EventBatch, EventShapes, HistogramSet, Hist1D/2D)
+//   - 2: Hist1D/2D carry their fill cost counters
+//   - 3: EventBatch carries lab-frame particles
+#define EPNEC_PLUGIN_ABI 3
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! A span of events of a batch, with their shapes
+  // ==========================================================================
+  struct ObservableSpan {
+    const EventBatch&               batch;      //!< batch the events are in
+    std::size_t                     first;      //!< first event
+    std::size_t                     last;       //!< one past last event
+    const std::vector<EventShapes>& recShapes;  //!< reconstructed event shapes, indexed like the batch
+    const std::vector<EventShapes>& genShapes;  //!< generated event shapes, indexed like the batch
+  };
+
+
+
+  // ==========================================================================
+  //! User observable
+  // --------------------------------------------------------------------------
+  //! Base class for observables compiled outside of
+  //! the package. Book() adds histograms to the
+  //! Calculator's template set (keep the returned
+  //! indices); every thread then gets a copy of
+  //! that set, and Fill() is called with the filling
+  //! thread's own copy, which is merged and written
+  //! along with everything else. Fill() runs on
+  //! several threads at once, so it mustn't change
+  //! the observable, except for per-worker scratch
+  //! sized in Book().
+  // ==========================================================================
+  class Observable {
+
+    public:
+
+      // ctor/dtor
+      Observable()          {};
+      virtual ~Observable() {};
+
+      // interface
+      virtual std::string Name() const = 0;
+      virtual void        Book(HistogramSet& hists, const unsigned nWorkers) = 0;
+      virtual void        Fill(const ObservableSpan& span, HistogramSet& hists, const unsigned iWorker) = 0;
+
+  };  // end Observable
+
+
+
+  // ==========================================================================
+  //! Observable loaded from a plugin library
+  // --------------------------------------------------------------------------
+  //! Plugins are shared libraries which define an
+  //! Observable and export it with
+  //! EPNEC_REGISTER_OBSERVABLE(Class). The library
+  //! stays loaded as long as this object lives.
+  // ==========================================================================
+  class ObservablePlugin {
+
+    public:
+
+      // ctor/dtor
+      ObservablePlugin()  {};
+      ~ObservablePlugin();
+
+      // interface
+      bool Load(const std::string& path);
+
+      // getters
+      Observable&        Get() {return *m_observable;}
+      const std::string& GetPath() const {return m_path;}
+
+    private:
+
+      // members
+      void*                       m_handle = nullptr;
+      std::string                 m_path;
+      std::unique_ptr<Observable> m_observable;
+
+  };  // end ObservablePlugin
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// export an observable from a plugin library
+#define EPNEC_REGISTER_OBSERVABLE(type)                                         \
+  extern "C" int epnec_plugin_abi() {return EPNEC_PLUGIN_ABI;}                  \
+  extern "C" EPNucleonEnergyCorrelator::Observable* epnec_create_observable() { \
+    return new type();                                                          \
+  }
+
+#endif
+
+// end ========================================================================
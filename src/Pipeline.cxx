@@ -0,0 +1,212 @@
+// ============================================================================
+//! \file   Pipeline.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Streams batches from the Extractor straight to
+//! the Calculator, splitting threads between the
+//! two stages adaptively.
+// ============================================================================
+
+#include "Pipeline.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  Pipeline::Pipeline(Extractor& extractor, Calculator& calculator, const PipelineOptions& opt) :
+    m_extractor(extractor),
+    m_calculator(calculator),
+    m_opt(opt),
+    m_nExtract(std::max(1u, opt.nThreads / 2)),
+    m_nextUnit(0),
+    m_nBusy(0),
+    m_done(false)
+  {
+
+    m_opt.nThreads   = std::max(1u, m_opt.nThreads);
+    m_opt.queueDepth = std::max<std::size_t>(1, m_opt.queueDepth);
+
+  }  // end ctor(Extractor&, Calculator&, PipelineOptions&)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Run both stages until all units are processed
+  // --------------------------------------------------------------------------
+  void Pipeline::Run() {
+
+    m_extractor.SetSink([this](EventBatch& batch, const unsigned iWorker) {
+      Push(batch, iWorker);
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+      std::thread              controller(&Pipeline::Control, this);
+      std::vector<std::thread> workers;
+      for (unsigned iWorker = 0; iWorker < m_opt.nThreads; ++iWorker) {
+        workers.emplace_back(&Pipeline::Work, this, iWorker);
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+      m_done = true;
+      controller.join();
+    }
+
+    // partial batches are left once all threads stop
+    m_extractor.Flush();
+    EventBatch batch;
+    while (Pop(batch, false)) {
+      m_calculator.Process(batch, 0);
+    }
+    m_extractor.SetSink(nullptr);
+
+    const std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    std::cout << "    Pipeline finished in " << took.count() << " s:\n"
+              << "      mean extraction threads: " << m_meanExtract << " of " << m_opt.nThreads << "\n"
+              << "      threads moved:           " << m_nMoves
+              << std::endl;
+
+  }  // end 'Run()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Worker loop
+  // --------------------------------------------------------------------------
+  //! Workers below the current split extract units
+  //! while there are any left, all others (and
+  //! extractors once units run out) calculate.
+  void Pipeline::Work(const unsigned iWorker) {
+
+    const std::size_t nUnits = m_extractor.NUnits();
+    while (true) {
+
+      if (iWorker < m_nExtract) {
+        ++m_nBusy;
+        const std::size_t iUnit = m_nextUnit++;
+        if (iUnit < nUnits) {
+          m_extractor.Extract(iUnit, iWorker);
+        }
+        --m_nBusy;
+        if (iUnit < nUnits) continue;
+      }
+
+      EventBatch batch;
+      if (Pop(batch, true)) {
+        m_calculator.Process(batch, iWorker);
+        continue;
+      }
+
+      // n.b. a busy extractor may still push batches
+      if ((m_nextUnit >= nUnits) && (m_nBusy == 0)) {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_queue.empty()) break;
+      }
+    }
+
+  }  // end 'Work(unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Controller loop
+  // --------------------------------------------------------------------------
+  void Pipeline::Control() {
+
+    const std::size_t nUnits  = m_extractor.NUnits();
+    unsigned          nAbove  = 0;
+    unsigned          nBelow  = 0;
+    uint64_t          nSample = 0;
+    double            sum     = 0.;
+    while (!m_done) {
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(m_opt.intervalMs));
+
+      double occupancy = 0.;
+      {
+        std::lock_guard<std::mutex> guard(m_lock);
+        occupancy = static_cast<double>(m_queue.size()) / m_opt.queueDepth;
+      }
+
+      // count consecutive samples past either threshold
+      nAbove = (occupancy > m_opt.highWater) ? nAbove + 1 : 0;
+      nBelow = (occupancy < m_opt.lowWater) ? nBelow + 1 : 0;
+
+      const unsigned nExtract = m_nExtract;
+      if ((nAbove >= m_opt.patience) && (nExtract > 1)) {
+        m_nExtract = nExtract - 1;
+        ++m_nMoves;
+        nAbove = 0;
+      } else if ((nBelow >= m_opt.patience) && (nExtract < m_opt.nThreads) && (m_nextUnit < nUnits)) {
+        m_nExtract = nExtract + 1;
+        ++m_nMoves;
+        nBelow = 0;
+      }
+
+      sum += m_nExtract;
+      ++nSample;
+    }
+    m_meanExtract = (nSample > 0) ? sum / nSample : m_nExtract.load();
+
+  }  // end 'Control()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Hand a full batch to the calculation stage
+  // --------------------------------------------------------------------------
+  //! If the queue is full the producing thread runs
+  //! the calculation itself instead of blocking, so
+  //! the pipeline can't stall whatever the split.
+  void Pipeline::Push(EventBatch& batch, const unsigned iWorker) {
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (m_queue.size() >= m_opt.queueDepth) {
+      EventBatch other = std::move(m_queue.front());
+      m_queue.pop_front();
+      guard.unlock();
+      m_calculator.Process(other, iWorker);
+      guard.lock();
+    }
+    m_queue.push_back(std::move(batch));
+    guard.unlock();
+    m_ready.notify_one();
+
+  }  // end 'Push(EventBatch&, unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Take a batch from the queue
+  // --------------------------------------------------------------------------
+  //! If wait is set, waits briefly for one to arrive
+  //! so idle workers keep checking their role.
+  bool Pipeline::Pop(EventBatch& batch, const bool wait) {
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    if (wait && m_queue.empty()) {
+      m_ready.wait_for(guard, std::chrono::milliseconds(5));
+    }
+    if (m_queue.empty()) return false;
+
+    batch = std::move(m_queue.front());
+    m_queue.pop_front();
+    return true;
+
+  }  // end 'Pop(EventBatch&, bool)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
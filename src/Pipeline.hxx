@@ -0,0 +1,104 @@
+// ============================================================================
+//! \file   Pipeline.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Streams batches from the Extractor straight to
+//! the Calculator, splitting threads between the
+//! two stages adaptively.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Pipeline_hxx
+#define EPNucleonEnergyCorrelator_Pipeline_hxx
+
+// c++ utilities
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+// package components
+#include "Calculator.hxx"
+#include "EventBatch.hxx"
+#include "Extractor.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Pipeline options
+  // ==========================================================================
+  struct PipelineOptions {
+    unsigned    nThreads   = 2;     //!< total no. of threads for both stages
+    std::size_t queueDepth = 16;    //!< max no. of batches between stages
+    double      highWater  = 0.75;  //!< occupancy above which an extraction thread moves to calculation
+    double      lowWater   = 0.25;  //!< occupancy below which a calculation thread moves to extraction
+    unsigned    patience   = 4;     //!< no. of consecutive samples past a threshold before moving a thread
+    unsigned    intervalMs = 50;    //!< time between occupancy samples [ms]
+  };
+
+
+
+  // ==========================================================================
+  //! Extractor-to-Calculator pipeline
+  // --------------------------------------------------------------------------
+  //! Every thread can work on either stage. A
+  //! controller samples how full the queue between
+  //! the stages is: a filling queue means the
+  //! Calculator is the bottleneck, so a thread is
+  //! moved to it, and vice versa. A thread is only
+  //! moved after the occupancy stayed past a
+  //! threshold for several samples, and the gap
+  //! between the two thresholds keeps the split from
+  //! oscillating. The Extractor and Calculator must
+  //! be initialized with (at least) nThreads
+  //! workers. The threads aren't TaskPool workers,
+  //! so the Calculator runs pair loops of giant
+  //! events in one piece here rather than in tiles
+  //! (the grid approximation still applies).
+  // ==========================================================================
+  class Pipeline {
+
+    public:
+
+      // ctor/dtor
+      Pipeline(Extractor& extractor, Calculator& calculator, const PipelineOptions& opt = PipelineOptions());
+      ~Pipeline() {};
+
+      // interface
+      void Run();
+
+      // getters
+      uint64_t GetNMoves() const {return m_nMoves;}
+      double   GetMeanExtractors() const {return m_meanExtract;}
+
+    private:
+
+      // helper methods
+      void Work(const unsigned iWorker);
+      void Control();
+      void Push(EventBatch& batch, const unsigned iWorker);
+      bool Pop(EventBatch& batch, const bool wait);
+
+      // members
+      Extractor&               m_extractor;
+      Calculator&              m_calculator;
+      PipelineOptions          m_opt;
+      std::deque<EventBatch>   m_queue;
+      std::mutex               m_lock;
+      std::condition_variable  m_ready;
+      std::atomic<unsigned>    m_nExtract;
+      std::atomic<std::size_t> m_nextUnit;
+      std::atomic<unsigned>    m_nBusy;
+      std::atomic<bool>        m_done;
+      uint64_t                 m_nMoves      = 0;
+      double                   m_meanExtract = 0.;
+
+  };  // end Pipeline
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
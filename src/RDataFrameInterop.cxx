@@ -0,0 +1,131 @@
+// ============================================================================
+//! \file   RDataFrameInterop.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Callables and actions to run the Calculator's
+//! kernels inside RDataFrame chains, directly on
+//! their RVec columns.
+// ============================================================================
+
+#include "RDataFrameInterop.hxx"
+
+// c++ utilities
+#include <algorithm>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! View of the particles in a set of RVec columns
+  // --------------------------------------------------------------------------
+  ParticleView AdoptView(
+    const ROOT::RVec<float>& energy,
+    const ROOT::RVec<float>& px,
+    const ROOT::RVec<float>& py,
+    const ROOT::RVec<float>& pz,
+    const ROOT::RVec<int>& pdg
+  ) {
+
+    const std::size_t size = std::min({energy.size(), px.size(), py.size(), pz.size(), pdg.size()});
+    return {energy.data(), px.data(), py.data(), pz.data(), pdg.data(), size};
+
+  }  // end 'AdoptView(ROOT::RVec<float>& x 4, ROOT::RVec<int>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Compute the event shapes of one event
+  // --------------------------------------------------------------------------
+  EventShapes EventShapeColumn::operator()(
+    const unsigned slot,
+    const float q2,
+    const ROOT::RVec<float>& energy,
+    const ROOT::RVec<float>& px,
+    const ROOT::RVec<float>& py,
+    const ROOT::RVec<float>& pz,
+    const ROOT::RVec<int>& pdg
+  ) {
+
+    EventShapes shapes;
+    m_calculators[slot].Compute(AdoptView(energy, px, py, pz, pdg), q2, shapes);
+    return shapes;
+
+  }  // end 'operator()(unsigned, float, ROOT::RVec<float>& x 4, ROOT::RVec<int>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  //! n.b. the sets are copied here, before the event
+  //! loop, so slots never touch the Calculator's.
+  NECAction::NECAction(const Calculator& calc, const Calculator::Level level, const unsigned nSlots) :
+    m_calc(&calc),
+    m_level(level),
+    m_sets(std::max(1u, nSlots), calc.GetTemplate()),
+    m_scratch(std::max(1u, nSlots), calc.MakeScratch()),
+    m_result(new HistogramSet(calc.GetTemplate())) {
+
+    /* nothing to do */
+
+  }  // end ctor(Calculator&, Calculator::Level, unsigned)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill one event into its slot's set
+  // --------------------------------------------------------------------------
+  void NECAction::Exec(
+    const unsigned slot,
+    const float q2,
+    const float xb,
+    const ROOT::RVec<float>& energy,
+    const ROOT::RVec<float>& px,
+    const ROOT::RVec<float>& py,
+    const ROOT::RVec<float>& pz,
+    const ROOT::RVec<int>& pdg
+  ) {
+
+    m_calc->ProcessEvent(m_level, q2, xb, AdoptView(energy, px, py, pz, pdg), m_scratch[slot], m_sets[slot]);
+
+  }  // end 'Exec(unsigned, float, float, ROOT::RVec<float>& x 4, ROOT::RVec<int>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Merge the slots' sets into the result
+  // --------------------------------------------------------------------------
+  void NECAction::Finalize() {
+
+    for (const auto& set : m_sets) {
+      m_result->Merge(set);
+    }
+
+  }  // end 'Finalize()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Book NEC histograms of one level on a dataframe
+  // --------------------------------------------------------------------------
+  ROOT::RDF::RResultPtr<HistogramSet> BookNEC(
+    ROOT::RDF::RNode df,
+    const Calculator& calc,
+    const Calculator::Level level,
+    const std::vector<std::string>& columns
+  ) {
+
+    using Floats = ROOT::RVec<float>;
+    using Ints   = ROOT::RVec<int>;
+    return df.Book<float, float, Floats, Floats, Floats, Floats, Ints>(
+      NECAction(calc, level, df.GetNSlots()),
+      columns
+    );
+
+  }  // end 'BookNEC(ROOT::RDF::RNode, Calculator&, Calculator::Level, std::vector<std::string>&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,163 @@
+// ============================================================================
+//! \file   RDataFrameInterop.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Callables and actions to run the Calculator's
+//! kernels inside RDataFrame chains, directly on
+//! their RVec columns.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_RDataFrameInterop_hxx
+#define EPNucleonEnergyCorrelator_RDataFrameInterop_hxx
+
+// root libraries
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+// c++ utilities
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+// package components
+#include "Calculator.hxx"
+#include "EventBatch.hxx"
+#include "EventShapes.hxx"
+#include "Histogram.hxx"
+
+class TTreeReader;
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! View of the particles in a set of RVec columns
+  // --------------------------------------------------------------------------
+  //! Points at the RVecs' buffers, which RDataFrame
+  //! adopts from the tree without copying, so no
+  //! particle is copied either. Columns of unequal
+  //! length are cut to the shortest.
+  ParticleView AdoptView(
+    const ROOT::RVec<float>& energy,
+    const ROOT::RVec<float>& px,
+    const ROOT::RVec<float>& py,
+    const ROOT::RVec<float>& pz,
+    const ROOT::RVec<int>& pdg
+  );
+
+
+
+  // ==========================================================================
+  //! Event shapes as an RDataFrame column
+  // --------------------------------------------------------------------------
+  //! For DefineSlot(): keeps one shape calculator
+  //! (and its scratch) per slot, e.g.
+  //!   df.DefineSlot("shapes", EventShapeColumn(opt, df.GetNSlots()),
+  //!                 {"q2", "e", "px", "py", "pz", "pdg"});
+  // ==========================================================================
+  class EventShapeColumn {
+
+    public:
+
+      // ctor/dtor
+      EventShapeColumn(const EventShapeOptions& opt, const unsigned nSlots) :
+        m_calculators(std::max(1u, nSlots), EventShapeCalculator(opt)) {};
+      ~EventShapeColumn() {};
+
+      // rdataframe interface
+      EventShapes operator()(
+        const unsigned slot,
+        const float q2,
+        const ROOT::RVec<float>& energy,
+        const ROOT::RVec<float>& px,
+        const ROOT::RVec<float>& py,
+        const ROOT::RVec<float>& pz,
+        const ROOT::RVec<int>& pdg
+      );
+
+    private:
+
+      // members
+      std::vector<EventShapeCalculator> m_calculators;
+
+  };  // end EventShapeColumn
+
+
+
+  // ==========================================================================
+  //! NEC histograms as an RDataFrame action
+  // --------------------------------------------------------------------------
+  //! Fills the histograms an initialized Calculator
+  //! books, for one level (rec or gen), from columns
+  //! (q2, xb, energy, px, py, pz, pdg) of types
+  //! (float, float, RVec<float> x 4, RVec<int>).
+  //! Each slot fills its own copy of the
+  //! Calculator's template set, and the copies are
+  //! merged when the event loop ends; write the
+  //! result with WriteHistograms(). The Calculator
+  //! must outlive the event loop. See BookNEC().
+  // ==========================================================================
+  class NECAction : public ROOT::Detail::RDF::RActionImpl<NECAction> {
+
+    public:
+
+      // result of the action
+      using Result_t = HistogramSet;
+
+      // ctor/dtor
+      NECAction(const Calculator& calc, const Calculator::Level level, const unsigned nSlots);
+      NECAction(NECAction&&) = default;
+      NECAction(const NECAction&) = delete;
+      ~NECAction() {};
+
+      // rdataframe interface
+      void                      Initialize() {};
+      void                      InitTask(TTreeReader*, unsigned) {};
+      void                      Finalize();
+      std::shared_ptr<Result_t> GetResultPtr() const {return m_result;}
+      std::string               GetActionName() const {return "NEC";}
+      void                      Exec(
+        const unsigned slot,
+        const float q2,
+        const float xb,
+        const ROOT::RVec<float>& energy,
+        const ROOT::RVec<float>& px,
+        const ROOT::RVec<float>& py,
+        const ROOT::RVec<float>& pz,
+        const ROOT::RVec<int>& pdg
+      );
+
+    private:
+
+      // members
+      const Calculator*                     m_calc;
+      Calculator::Level                     m_level;
+      std::vector<HistogramSet>             m_sets;
+      std::vector<Calculator::EventScratch> m_scratch;
+      std::shared_ptr<HistogramSet>         m_result;
+
+  };  // end NECAction
+
+
+
+  // --------------------------------------------------------------------------
+  //! Book NEC histograms of one level on a dataframe
+  // --------------------------------------------------------------------------
+  //! Columns are (q2, xb, energy, px, py, pz, pdg),
+  //! e.g. {"Q2", "xB", "pars.energy", "pars.momentum.x",
+  //! "pars.momentum.y", "pars.momentum.z", "pars.PDG"};
+  //! Define() float copies of double event-level
+  //! columns first.
+  ROOT::RDF::RResultPtr<HistogramSet> BookNEC(
+    ROOT::RDF::RNode df,
+    const Calculator& calc,
+    const Calculator::Level level,
+    const std::vector<std::string>& columns
+  );
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
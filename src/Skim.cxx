@@ -0,0 +1,924 @@
+// ============================================================================
+//! \file   Skim.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Columnar skim format written by the Extractor
+//! and read by the Calculator.
+// ============================================================================
+
+#include "Skim.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+// posix utilities
+#include <fcntl.h>
+#include <unistd.h>
+// compression libraries
+#ifdef EPNEC_USE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+#ifdef EPNEC_USE_LZ4
+#include <lz4.h>
+#endif
+// linux i/o libraries
+#ifdef EPNEC_USE_URING
+#include <liburing.h>
+#include <sys/uio.h>
+#endif
+
+
+
+namespace {
+
+  // file layout:
+  //   magic | pages ... | footer | footer offset (u64) | magic
+  // footer:
+  //   no. of clusters (u64) | no. of columns (u32) |
+  //   per column: name, dictionary | no. of pages (u64) |
+  //   per page: SkimPage fields
+  constexpr char     Magic[8] = {'E', 'P', 'N', 'S', 'K', 'I', 'M', '1'};
+  constexpr uint32_t Version  = 1;
+
+  template <typename T> void put(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void putBytes(std::vector<char>& buffer, const char* data, const uint64_t size) {
+    put(buffer, size);
+    buffer.insert(buffer.end(), data, data + size);
+  }
+
+  template <typename T> bool get(const std::vector<char>& buffer, std::size_t& pos, T& value) {
+    if (pos + sizeof(T) > buffer.size()) return false;
+    std::memcpy(&value, buffer.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  bool getBytes(const std::vector<char>& buffer, std::size_t& pos, std::vector<char>& out) {
+    uint64_t size = 0;
+    if (!get(buffer, pos, size) || (size > buffer.size() - pos)) return false;
+    out.assign(buffer.data() + pos, buffer.data() + pos + size);
+    pos += size;
+    return true;
+  }
+
+  // append a typed column slice as raw bytes
+  template <typename T> void appendRows(const std::vector<T>& column, const std::size_t first, const std::size_t last, std::vector<char>& out) {
+    const char* bytes = reinterpret_cast<const char*>(column.data() + first);
+    out.insert(out.end(), bytes, bytes + (last - first) * sizeof(T));
+  }
+
+  // append raw bytes to a typed column, false if
+  // they aren't whole rows
+  template <typename T> bool appendBytes(std::vector<T>& column, const char* data, const std::size_t size) {
+    if (size % sizeof(T) != 0) return false;
+    if (size == 0) return true;
+    const std::size_t start = column.size();
+    column.resize(start + size / sizeof(T));
+    std::memcpy(column.data() + start, data, size);
+    return true;
+  }
+
+  // append per-event counts as offsets, false if
+  // they aren't whole rows or overflow
+  bool appendCounts(std::vector<uint32_t>& offsets, const char* data, const std::size_t size) {
+    if (size % sizeof(uint32_t) != 0) return false;
+    for (std::size_t pos = 0; pos < size; pos += sizeof(uint32_t)) {
+      uint32_t count = 0;
+      std::memcpy(&count, data + pos, sizeof(uint32_t));
+      if (offsets.back() + static_cast<uint64_t>(count) > std::numeric_limits<uint32_t>::max()) return false;
+      offsets.push_back(offsets.back() + count);
+    }
+    return true;
+  }
+
+  // check particle columns hold nEvents events (or
+  // none, if optional) and line up with their offsets
+  bool checkParticles(const EPNucleonEnergyCorrelator::ParticleColumns& pars, const std::size_t nEvents, const bool optional) {
+    const std::size_t size = pars.energy.size();
+    if (optional && (pars.offsets.size() == 1) && (size == 0)) return true;
+    return (pars.NEvents() == nEvents)
+        && (pars.offsets.back() == size)
+        && (pars.px.size() == size)
+        && (pars.py.size() == size)
+        && (pars.pz.size() == size)
+        && (pars.pdg.size() == size);
+  }
+
+  // check all columns of a batch line up
+  //   - n.b. offsets only go up, as they're summed
+  //     from counts
+  bool checkBatch(const EPNucleonEnergyCorrelator::EventBatch& batch) {
+    const std::size_t nEvents = batch.NEvents();
+    return (batch.q2Rec.size() == nEvents)
+        && (batch.q2Gen.size() == nEvents)
+        && (batch.xbRec.size() == nEvents)
+        && (batch.xbGen.size() == nEvents)
+        && checkParticles(batch.rec, nEvents, false)
+        && checkParticles(batch.gen, nEvents, false)
+        && checkParticles(batch.recLab, nEvents, true)
+        && checkParticles(batch.genLab, nEvents, true)
+        && (batch.recToGen.empty() || (batch.recToGen.size() == batch.rec.Size()));
+  }
+
+  // size of a page's entry in the footer
+  constexpr std::size_t PageBytes = 2 * sizeof(uint32_t) + sizeof(uint8_t) + 3 * sizeof(uint64_t);
+
+  // write per-event counts of events [first, last)
+  void countRows(const std::vector<uint32_t>& offsets, const std::size_t first, const std::size_t last, std::vector<char>& out) {
+    for (std::size_t iEvent = first; iEvent < last; ++iEvent) {
+      put<uint32_t>(out, offsets[iEvent + 1] - offsets[iEvent]);
+    }
+  }
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // column table -------------------------------------------------------------
+
+  namespace SkimColumns {
+
+    // n.b. the count columns must come before the
+    // particle columns of the same collection
+    const char* const Names[NColumns] = {
+      "key", "q2Rec", "q2Gen", "xbRec", "xbGen",
+      "rec.n", "rec.energy", "rec.px", "rec.py", "rec.pz", "rec.pdg", "recToGen",
+      "gen.n", "gen.energy", "gen.px", "gen.py", "gen.pz", "gen.pdg",
+      "recLab.n", "recLab.energy", "recLab.px", "recLab.py", "recLab.pz", "recLab.pdg",
+      "genLab.n", "genLab.energy", "genLab.px", "genLab.py", "genLab.pz", "genLab.pdg"
+    };
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get rows of a column in events [first, last)
+    // ------------------------------------------------------------------------
+    void Rows(
+      const EventBatch& batch,
+      const std::size_t iCol,
+      const std::size_t first,
+      const std::size_t last,
+      std::size_t& rowFirst,
+      std::size_t& rowLast
+    ) {
+
+      if ((iCol > 5) && (iCol < 12)) {
+        rowFirst = batch.rec.offsets[first];
+        rowLast  = batch.rec.offsets[last];
+      } else if ((iCol > 12) && (iCol < 18)) {
+        rowFirst = batch.gen.offsets[first];
+        rowLast  = batch.gen.offsets[last];
+      } else if ((iCol > 18) && (iCol < 24)) {
+        rowFirst = batch.HasRecLab() ? batch.recLab.offsets[first] : 0;
+        rowLast  = batch.HasRecLab() ? batch.recLab.offsets[last] : 0;
+      } else if (iCol > 24) {
+        rowFirst = batch.HasGenLab() ? batch.genLab.offsets[first] : 0;
+        rowLast  = batch.HasGenLab() ? batch.genLab.offsets[last] : 0;
+      } else {
+        rowFirst = first;
+        rowLast  = last;
+      }
+
+    }  // end 'Rows(EventBatch&, std::size_t x 3, std::size_t& x 2)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Get bytes of a column in events [first, last)
+    // ------------------------------------------------------------------------
+    void Get(
+      const EventBatch& batch,
+      const std::size_t iCol,
+      const std::size_t first,
+      const std::size_t last,
+      std::vector<char>& out
+    ) {
+
+      std::size_t rowFirst = 0;
+      std::size_t rowLast  = 0;
+      Rows(batch, iCol, first, last, rowFirst, rowLast);
+
+      out.clear();
+      switch (iCol) {
+        case 0:  appendRows(batch.key, rowFirst, rowLast, out); break;
+        case 1:  appendRows(batch.q2Rec, rowFirst, rowLast, out); break;
+        case 2:  appendRows(batch.q2Gen, rowFirst, rowLast, out); break;
+        case 3:  appendRows(batch.xbRec, rowFirst, rowLast, out); break;
+        case 4:  appendRows(batch.xbGen, rowFirst, rowLast, out); break;
+        case 5:  countRows(batch.rec.offsets, first, last, out); break;
+        case 6:  appendRows(batch.rec.energy, rowFirst, rowLast, out); break;
+        case 7:  appendRows(batch.rec.px, rowFirst, rowLast, out); break;
+        case 8:  appendRows(batch.rec.py, rowFirst, rowLast, out); break;
+        case 9:  appendRows(batch.rec.pz, rowFirst, rowLast, out); break;
+        case 10: appendRows(batch.rec.pdg, rowFirst, rowLast, out); break;
+        case 11:
+          if (!batch.recToGen.empty()) appendRows(batch.recToGen, rowFirst, rowLast, out);
+          break;
+        case 12: countRows(batch.gen.offsets, first, last, out); break;
+        case 13: appendRows(batch.gen.energy, rowFirst, rowLast, out); break;
+        case 14: appendRows(batch.gen.px, rowFirst, rowLast, out); break;
+        case 15: appendRows(batch.gen.py, rowFirst, rowLast, out); break;
+        case 16: appendRows(batch.gen.pz, rowFirst, rowLast, out); break;
+        case 17: appendRows(batch.gen.pdg, rowFirst, rowLast, out); break;
+        case 18:
+          if (batch.HasRecLab()) countRows(batch.recLab.offsets, first, last, out);
+          break;
+        case 19: appendRows(batch.recLab.energy, rowFirst, rowLast, out); break;
+        case 20: appendRows(batch.recLab.px, rowFirst, rowLast, out); break;
+        case 21: appendRows(batch.recLab.py, rowFirst, rowLast, out); break;
+        case 22: appendRows(batch.recLab.pz, rowFirst, rowLast, out); break;
+        case 23: appendRows(batch.recLab.pdg, rowFirst, rowLast, out); break;
+        case 24:
+          if (batch.HasGenLab()) countRows(batch.genLab.offsets, first, last, out);
+          break;
+        case 25: appendRows(batch.genLab.energy, rowFirst, rowLast, out); break;
+        case 26: appendRows(batch.genLab.px, rowFirst, rowLast, out); break;
+        case 27: appendRows(batch.genLab.py, rowFirst, rowLast, out); break;
+        case 28: appendRows(batch.genLab.pz, rowFirst, rowLast, out); break;
+        case 29: appendRows(batch.genLab.pdg, rowFirst, rowLast, out); break;
+        default: break;
+      }
+
+    }  // end 'Get(EventBatch&, std::size_t x 3, std::vector<char>&)'
+
+
+
+    // ------------------------------------------------------------------------
+    //! Append bytes to a column
+    // ------------------------------------------------------------------------
+    //! Returns false if the bytes aren't whole rows.
+    bool Append(EventBatch& batch, const std::size_t iCol, const char* data, const std::size_t size) {
+
+      switch (iCol) {
+        case 0:  return appendBytes(batch.key, data, size);
+        case 1:  return appendBytes(batch.q2Rec, data, size);
+        case 2:  return appendBytes(batch.q2Gen, data, size);
+        case 3:  return appendBytes(batch.xbRec, data, size);
+        case 4:  return appendBytes(batch.xbGen, data, size);
+        case 5:  return appendCounts(batch.rec.offsets, data, size);
+        case 6:  return appendBytes(batch.rec.energy, data, size);
+        case 7:  return appendBytes(batch.rec.px, data, size);
+        case 8:  return appendBytes(batch.rec.py, data, size);
+        case 9:  return appendBytes(batch.rec.pz, data, size);
+        case 10: return appendBytes(batch.rec.pdg, data, size);
+        case 11: return appendBytes(batch.recToGen, data, size);
+        case 12: return appendCounts(batch.gen.offsets, data, size);
+        case 13: return appendBytes(batch.gen.energy, data, size);
+        case 14: return appendBytes(batch.gen.px, data, size);
+        case 15: return appendBytes(batch.gen.py, data, size);
+        case 16: return appendBytes(batch.gen.pz, data, size);
+        case 17: return appendBytes(batch.gen.pdg, data, size);
+        case 18: return appendCounts(batch.recLab.offsets, data, size);
+        case 19: return appendBytes(batch.recLab.energy, data, size);
+        case 20: return appendBytes(batch.recLab.px, data, size);
+        case 21: return appendBytes(batch.recLab.py, data, size);
+        case 22: return appendBytes(batch.recLab.pz, data, size);
+        case 23: return appendBytes(batch.recLab.pdg, data, size);
+        case 24: return appendCounts(batch.genLab.offsets, data, size);
+        case 25: return appendBytes(batch.genLab.energy, data, size);
+        case 26: return appendBytes(batch.genLab.px, data, size);
+        case 27: return appendBytes(batch.genLab.py, data, size);
+        case 28: return appendBytes(batch.genLab.pz, data, size);
+        case 29: return appendBytes(batch.genLab.pdg, data, size);
+        default: return false;
+      }
+
+    }  // end 'Append(EventBatch&, std::size_t, char*, std::size_t)'
+
+  }  // end SkimColumns namespace
+
+
+
+  // writer -------------------------------------------------------------------
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  SkimWriter::~SkimWriter() {
+
+    if (m_file) Close();
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Open output file
+  // --------------------------------------------------------------------------
+  //! Closes any skim still open, and resets the
+  //! writer's state, so a writer can be reused for
+  //! several files.
+  bool SkimWriter::Open(const std::string& path) {
+
+    if (m_file) Close();
+    m_nCluster = 0;
+    m_rawBytes = 0;
+    m_zipBytes = 0;
+    m_held.clear();
+    m_pages.clear();
+
+    // fall back to no compression if a codec wasn't compiled in
+#ifndef EPNEC_USE_ZSTD
+    if ((m_opt.codec == Codec::Zstd) || (m_opt.codec == Codec::ZstdDict)) {
+      std::cerr << "WARNING: built without zstd, skim will be uncompressed" << std::endl;
+      m_opt.codec = Codec::None;
+    }
+#else
+    m_cctx = ZSTD_createCCtx();
+#endif
+#ifndef EPNEC_USE_LZ4
+    if (m_opt.codec == Codec::LZ4) {
+      std::cerr << "WARNING: built without lz4, skim will be uncompressed" << std::endl;
+      m_opt.codec = Codec::None;
+    }
+#endif
+
+    m_file = std::fopen(path.data(), "wb");
+    if (!m_file) {
+      std::cerr << "PANIC: couldn't open skim '" << path << "'!" << std::endl;
+      return false;
+    }
+    std::fwrite(Magic, 1, sizeof(Magic), m_file);
+    std::fwrite(&Version, sizeof(Version), 1, m_file);
+    m_offset  = sizeof(Magic) + sizeof(Version);
+    m_trained = (m_opt.codec != Codec::ZstdDict);
+    m_dicts.assign(SkimColumns::NColumns, {});
+    m_cdicts.assign(SkimColumns::NColumns, nullptr);
+    return true;
+
+  }  // end 'Open(std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write a batch as one cluster
+  // --------------------------------------------------------------------------
+  //! Empty batches are skipped, so every cluster has
+  //! pages (which the reader relies on to check the
+  //! no. of clusters).
+  bool SkimWriter::Write(const EventBatch& batch) {
+
+    if (!m_file) return false;
+    if (batch.NEvents() == 0) return true;
+
+    std::vector<RawPage> pages;
+    Paginate(batch, pages);
+    ++m_nCluster;
+
+    // hold pages back until there are enough to train on
+    if (!m_trained) {
+      for (auto& page : pages) {
+        m_held.push_back(std::move(page));
+      }
+      return (m_nCluster < m_opt.trainBatches) || Train();
+    }
+
+    bool good = true;
+    for (const auto& page : pages) {
+      good = good && Flush(page);
+    }
+    return good;
+
+  }  // end 'Write(EventBatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Write footer and close file
+  // --------------------------------------------------------------------------
+  bool SkimWriter::Close() {
+
+    if (!m_file) return false;
+    bool good = m_trained || Train();
+
+    std::vector<char> footer;
+    put<uint64_t>(footer, m_nCluster);
+    put<uint32_t>(footer, SkimColumns::NColumns);
+    for (std::size_t iCol = 0; iCol < SkimColumns::NColumns; ++iCol) {
+      const std::string name = SkimColumns::Names[iCol];
+      putBytes(footer, name.data(), name.size());
+      putBytes(footer, m_dicts[iCol].data(), m_dicts[iCol].size());
+    }
+    put<uint64_t>(footer, m_pages.size());
+    for (const auto& page : m_pages) {
+      put(footer, page.column);
+      put(footer, page.cluster);
+      put(footer, page.codec);
+      put(footer, page.offset);
+      put(footer, page.zipBytes);
+      put(footer, page.rawBytes);
+    }
+    put<uint64_t>(footer, m_offset);
+    footer.insert(footer.end(), Magic, Magic + sizeof(Magic));
+
+    good = good && (std::fwrite(footer.data(), 1, footer.size(), m_file) == footer.size());
+    std::fclose(m_file);
+    m_file = nullptr;
+
+#ifdef EPNEC_USE_ZSTD
+    for (void* cdict : m_cdicts) {
+      ZSTD_freeCDict(static_cast<ZSTD_CDict*>(cdict));
+    }
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(m_cctx));
+    m_cctx = nullptr;
+#endif
+    m_cdicts.clear();
+    return good;
+
+  }  // end 'Close()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Split a batch into raw pages
+  // --------------------------------------------------------------------------
+  //! Empty pages (e.g. lab-frame columns of a batch
+  //! without them) aren't kept: the reader treats
+  //! missing pages as empty columns.
+  void SkimWriter::Paginate(const EventBatch& batch, std::vector<RawPage>& pages) {
+
+    const std::size_t nEvents = batch.NEvents();
+    const std::size_t step    = std::max<std::size_t>(1, m_opt.eventsPerPage);
+    for (std::size_t iCol = 0; iCol < SkimColumns::NColumns; ++iCol) {
+      for (std::size_t first = 0; first < nEvents; first += step) {
+        RawPage page;
+        page.column  = iCol;
+        page.cluster = m_nCluster;
+        SkimColumns::Get(batch, iCol, first, std::min(nEvents, first + step), page.data);
+        if (page.data.empty()) continue;
+        pages.push_back(std::move(page));
+      }
+    }
+
+  }  // end 'Paginate(EventBatch&, std::vector<RawPage>&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Compress and write a page
+  // --------------------------------------------------------------------------
+  //! Pages which don't shrink are stored as is.
+  bool SkimWriter::Flush(const RawPage& page) {
+
+    SkimPage    meta;
+    const char* data = page.data.data();
+    std::size_t size = page.data.size();
+    meta.column   = page.column;
+    meta.cluster  = page.cluster;
+    meta.codec    = static_cast<uint8_t>(Codec::None);
+    meta.offset   = m_offset;
+    meta.rawBytes = size;
+
+    std::size_t zipped = 0;
+#ifdef EPNEC_USE_ZSTD
+    if ((m_opt.codec == Codec::Zstd) || (m_opt.codec == Codec::ZstdDict)) {
+      m_zip.resize(ZSTD_compressBound(size));
+      ZSTD_CCtx*  cctx  = static_cast<ZSTD_CCtx*>(m_cctx);
+      ZSTD_CDict* cdict = static_cast<ZSTD_CDict*>(m_cdicts[page.column]);
+      zipped = cdict
+        ? ZSTD_compress_usingCDict(cctx, m_zip.data(), m_zip.size(), data, size, cdict)
+        : ZSTD_compressCCtx(cctx, m_zip.data(), m_zip.size(), data, size, m_opt.level);
+      if (ZSTD_isError(zipped)) zipped = 0;
+      meta.codec = static_cast<uint8_t>(cdict ? Codec::ZstdDict : Codec::Zstd);
+    }
+#endif
+#ifdef EPNEC_USE_LZ4
+    if (m_opt.codec == Codec::LZ4) {
+      m_zip.resize(LZ4_compressBound(size));
+      zipped     = std::max(0, LZ4_compress_default(data, m_zip.data(), size, m_zip.size()));
+      meta.codec = static_cast<uint8_t>(Codec::LZ4);
+    }
+#endif
+    if ((zipped > 0) && (zipped < size)) {
+      data = m_zip.data();
+      size = zipped;
+    } else {
+      meta.codec = static_cast<uint8_t>(Codec::None);
+    }
+
+    meta.zipBytes = size;
+    m_rawBytes   += meta.rawBytes;
+    m_zipBytes   += meta.zipBytes;
+    m_offset     += size;
+    m_pages.push_back(meta);
+    return std::fwrite(data, 1, size, m_file) == size;
+
+  }  // end 'Flush(RawPage&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Train per-column dictionaries on held pages
+  // --------------------------------------------------------------------------
+  //! Columns whose training fails (e.g. too few
+  //! samples) just use plain zstd. Returns false
+  //! if any held page couldn't be written.
+  bool SkimWriter::Train() {
+
+#ifdef EPNEC_USE_ZSTD
+    for (std::size_t iCol = 0; iCol < SkimColumns::NColumns; ++iCol) {
+
+      std::vector<char>   samples;
+      std::vector<size_t> sizes;
+      for (const auto& page : m_held) {
+        if ((page.column != iCol) || page.data.empty()) continue;
+        samples.insert(samples.end(), page.data.begin(), page.data.end());
+        sizes.push_back(page.data.size());
+      }
+      if (sizes.empty()) continue;
+
+      std::vector<char> dict(m_opt.dictSize);
+      const std::size_t size = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples.data(), sizes.data(), sizes.size());
+      if (ZDICT_isError(size)) continue;
+
+      dict.resize(size);
+      m_cdicts[iCol] = ZSTD_createCDict(dict.data(), dict.size(), m_opt.level);
+      m_dicts[iCol]  = std::move(dict);
+    }
+#endif
+
+    m_trained = true;
+    bool good = true;
+    for (const auto& page : m_held) {
+      good = good && Flush(page);
+    }
+    m_held.clear();
+    return good;
+
+  }  // end 'Train()'
+
+
+
+  // reader -------------------------------------------------------------------
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  SkimReader::~SkimReader() {
+
+    Close();
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Open a skim and read its footer
+  // --------------------------------------------------------------------------
+  bool SkimReader::Open(const std::string& path) {
+
+    Close();
+    m_fd = ::open(path.data(), O_RDONLY);
+    if (m_fd < 0) {
+      std::cerr << "PANIC: couldn't open skim '" << path << "'!" << std::endl;
+      return false;
+    }
+
+    // locate footer
+    const off_t end = ::lseek(m_fd, 0, SEEK_END);
+    std::vector<char> tail(sizeof(uint64_t) + sizeof(Magic));
+    if ((end < static_cast<off_t>(tail.size())) || !ReadAt(end - tail.size(), tail.size(), tail.data())) {
+      return false;
+    }
+    if (!std::equal(Magic, Magic + sizeof(Magic), tail.data() + sizeof(uint64_t))) {
+      std::cerr << "PANIC: '" << path << "' is not a skim!" << std::endl;
+      return false;
+    }
+
+    uint64_t    start = 0;
+    std::size_t pos   = 0;
+    get(tail, pos, start);
+
+    // check header
+    std::vector<char> head(sizeof(Magic) + sizeof(Version));
+    uint32_t          version = 0;
+    pos = sizeof(Magic);
+    if (!ReadAt(0, head.size(), head.data()) || !get(head, pos, version) || (version != Version)) {
+      std::cerr << "PANIC: skim '" << path << "' has version " << version << ", expected " << Version << "!" << std::endl;
+      return false;
+    }
+    if ((start < head.size()) || (start > static_cast<uint64_t>(end) - tail.size())) {
+      std::cerr << "PANIC: corrupt footer in skim '" << path << "'!" << std::endl;
+      return false;
+    }
+
+    std::vector<char> footer(end - tail.size() - start);
+    if (!ReadAt(start, footer.size(), footer.data())) return false;
+
+    // unpack column table and page index
+    uint64_t nClusters = 0;
+    uint32_t nColumns  = 0;
+    uint64_t nPages    = 0;
+    pos = 0;
+    // n.b. counts are checked before anything is
+    // sized from them: every page takes PageBytes
+    // of the footer, and every cluster has a page
+    bool good = get(footer, pos, nClusters)
+             && get(footer, pos, nColumns)
+             && ((nColumns == SkimColumns::NColumns) || (nColumns == SkimColumns::NBreitColumns));
+    m_dicts.assign(good ? nColumns : 0, {});
+    for (uint32_t iCol = 0; good && (iCol < nColumns); ++iCol) {
+      std::vector<char> name;
+      good = getBytes(footer, pos, name) && getBytes(footer, pos, m_dicts[iCol]);
+    }
+    good = good
+        && get(footer, pos, nPages)
+        && (nPages <= (footer.size() - pos) / PageBytes)
+        && (nClusters <= nPages);
+    m_pages.resize(good ? nPages : 0);
+    for (auto& page : m_pages) {
+      good = good
+          && get(footer, pos, page.column)
+          && get(footer, pos, page.cluster)
+          && get(footer, pos, page.codec)
+          && get(footer, pos, page.offset)
+          && get(footer, pos, page.zipBytes)
+          && get(footer, pos, page.rawBytes)
+          && (page.column < nColumns)
+          && (page.cluster < nClusters)
+          && (page.zipBytes <= start)
+          && (page.offset <= start - page.zipBytes)
+          && ((page.codec != static_cast<uint8_t>(Codec::None)) || (page.zipBytes == page.rawBytes));
+    }
+    if (!good) {
+      std::cerr << "PANIC: corrupt footer in skim '" << path << "'!" << std::endl;
+      return false;
+    }
+
+    // group pages by cluster
+    std::stable_sort(m_pages.begin(), m_pages.end(), [](const SkimPage& lhs, const SkimPage& rhs) {
+      return lhs.cluster < rhs.cluster;
+    });
+    m_nClusters = nClusters;
+    m_clusterStart.assign(nClusters + 1, m_pages.size());
+    for (std::size_t iPage = m_pages.size(); iPage-- > 0;) {
+      m_clusterStart[m_pages[iPage].cluster] = iPage;
+    }
+    for (std::size_t iCluster = nClusters; iCluster-- > 0;) {
+      m_clusterStart[iCluster] = std::min(m_clusterStart[iCluster], m_clusterStart[iCluster + 1]);
+    }
+
+#ifdef EPNEC_USE_ZSTD
+    m_dctx = ZSTD_createDCtx();
+    m_ddicts.assign(nColumns, nullptr);
+    for (uint32_t iCol = 0; iCol < nColumns; ++iCol) {
+      if (m_dicts[iCol].empty()) continue;
+      m_ddicts[iCol] = ZSTD_createDDict(m_dicts[iCol].data(), m_dicts[iCol].size());
+    }
+#endif
+
+    // set up io_uring with one registered arena
+    //   - n.b. the arena can't move once registered
+    if (m_opt.backend == ReadBackend::Uring) {
+#ifdef EPNEC_USE_URING
+      io_uring* ring = new io_uring;
+      m_arena.resize(std::max<std::size_t>(m_opt.arenaBytes, 4096));
+      const iovec arena = {m_arena.data(), m_arena.size()};
+      if (io_uring_queue_init(std::max(1u, m_opt.queueDepth), ring, 0) < 0) {
+        std::cerr << "WARNING: couldn't set up io_uring, reading skim with pread" << std::endl;
+        delete ring;
+      } else if (io_uring_register_buffers(ring, &arena, 1) < 0) {
+        std::cerr << "WARNING: couldn't register io_uring buffer, reading skim with pread" << std::endl;
+        io_uring_queue_exit(ring);
+        delete ring;
+      } else {
+        m_ring = ring;
+      }
+#else
+      std::cerr << "WARNING: built without liburing, reading skim with pread" << std::endl;
+#endif
+    }
+    return true;
+
+  }  // end 'Open(std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read a cluster into a batch
+  // --------------------------------------------------------------------------
+  bool SkimReader::Read(const std::size_t iCluster, EventBatch& batch) {
+
+    batch.Clear();
+    if (iCluster >= m_nClusters) return false;
+
+    bool good = true;
+    if (m_ring) {
+      good = ReadQueued(m_clusterStart[iCluster], m_clusterStart[iCluster + 1], batch);
+    } else {
+      for (std::size_t iPage = m_clusterStart[iCluster]; good && (iPage < m_clusterStart[iCluster + 1]); ++iPage) {
+        const SkimPage& page = m_pages[iPage];
+        m_zip.resize(page.zipBytes);
+        good = ReadAt(page.offset, page.zipBytes, m_zip.data())
+            && Decompress(page, m_zip.data(), m_raw)
+            && SkimColumns::Append(batch, page.column, m_raw.data(), m_raw.size());
+      }
+    }
+
+    // n.b. the footer only says where pages are, so
+    // make sure what's in them adds up to a batch
+    if (!good || !checkBatch(batch)) {
+      std::cerr << "PANIC: couldn't read cluster " << iCluster << " of skim, it may be corrupt!" << std::endl;
+      batch.Clear();
+      return false;
+    }
+    return true;
+
+  }  // end 'Read(std::size_t, EventBatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Close file and free decompression state
+  // --------------------------------------------------------------------------
+  void SkimReader::Close() {
+
+#ifdef EPNEC_USE_URING
+    if (m_ring) {
+      io_uring_queue_exit(static_cast<io_uring*>(m_ring));
+      delete static_cast<io_uring*>(m_ring);
+    }
+#endif
+    m_ring = nullptr;
+    m_arena.clear();
+    if (m_fd >= 0) {
+      ::close(m_fd);
+      m_fd = -1;
+    }
+#ifdef EPNEC_USE_ZSTD
+    for (void* ddict : m_ddicts) {
+      ZSTD_freeDDict(static_cast<ZSTD_DDict*>(ddict));
+    }
+    ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(m_dctx));
+#endif
+    m_dctx = nullptr;
+    m_ddicts.clear();
+    m_pages.clear();
+    m_nClusters = 0;
+
+  }  // end 'Close()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read bytes at an offset
+  // --------------------------------------------------------------------------
+  bool SkimReader::ReadAt(const uint64_t offset, const uint64_t size, char* buffer) {
+
+    uint64_t done = 0;
+    while (done < size) {
+      const ssize_t got = ::pread(m_fd, buffer + done, size - done, offset + done);
+      if (got <= 0) return false;
+      done += got;
+    }
+    m_bytesRead += size;
+    return true;
+
+  }  // end 'ReadAt(uint64_t, uint64_t, char*)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Read pages [first, last) into a batch through io_uring
+  // --------------------------------------------------------------------------
+  //! Pages go out in waves of up to queueDepth reads
+  //! that fit in the arena together, and are only
+  //! decompressed once the whole wave is in. Short
+  //! reads are finished with pread, and a page too
+  //! big for the arena is read with pread outright.
+  bool SkimReader::ReadQueued(const std::size_t first, const std::size_t last, EventBatch& batch) {
+
+#ifdef EPNEC_USE_URING
+    io_uring* ring = static_cast<io_uring*>(m_ring);
+    m_slots.resize(last - first);
+
+    std::size_t iPage = first;
+    while (iPage < last) {
+
+      // pack as many pages as fit into the arena
+      std::size_t end  = iPage;
+      uint64_t    used = 0;
+      while ((end < last) && (end - iPage < m_opt.queueDepth) && (used + m_pages[end].zipBytes <= m_arena.size())) {
+        m_slots[end - first] = used;
+        used += m_pages[end].zipBytes;
+        ++end;
+      }
+
+      if (end == iPage) {
+        const SkimPage& page = m_pages[iPage];
+        m_zip.resize(page.zipBytes);
+        if (!ReadAt(page.offset, page.zipBytes, m_zip.data())) return false;
+        if (!Decompress(page, m_zip.data(), m_raw)) return false;
+        if (!SkimColumns::Append(batch, page.column, m_raw.data(), m_raw.size())) return false;
+        ++iPage;
+        continue;
+      }
+
+      // queue the wave and wait for all of it
+      for (std::size_t jPage = iPage; jPage < end; ++jPage) {
+        io_uring_sqe* sqe = io_uring_get_sqe(ring);
+        io_uring_prep_read_fixed(sqe, m_fd, m_arena.data() + m_slots[jPage - first], m_pages[jPage].zipBytes, m_pages[jPage].offset, 0);
+        sqe->user_data = jPage;
+      }
+      if (io_uring_submit(ring) < 0) return false;
+
+      bool good = true;
+      for (std::size_t nDone = 0; nDone < end - iPage; ++nDone) {
+        io_uring_cqe* cqe = nullptr;
+        if (io_uring_wait_cqe(ring, &cqe) < 0) return false;
+
+        const std::size_t jPage = cqe->user_data;
+        const int64_t     got   = cqe->res;
+        io_uring_cqe_seen(ring, cqe);
+        if (got < 0) {
+          good = false;
+          continue;
+        }
+
+        const SkimPage& page = m_pages[jPage];
+        m_bytesRead += got;
+        if (static_cast<uint64_t>(got) < page.zipBytes) {
+          good = good && ReadAt(page.offset + got, page.zipBytes - got, m_arena.data() + m_slots[jPage - first] + got);
+        }
+      }
+      if (!good) return false;
+
+      // n.b. pages of a column must be appended in order
+      for (std::size_t jPage = iPage; jPage < end; ++jPage) {
+        const SkimPage& page = m_pages[jPage];
+        if (!Decompress(page, m_arena.data() + m_slots[jPage - first], m_raw)) return false;
+        if (!SkimColumns::Append(batch, page.column, m_raw.data(), m_raw.size())) return false;
+      }
+      iPage = end;
+    }
+    return true;
+#else
+    (void) first;
+    (void) last;
+    (void) batch;
+    return false;
+#endif
+
+  }  // end 'ReadQueued(std::size_t, std::size_t, EventBatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Decompress a page
+  // --------------------------------------------------------------------------
+  //! The raw size comes from the footer, so it's
+  //! checked against what the page can hold before
+  //! anything is allocated, and against what comes
+  //! out after.
+  bool SkimReader::Decompress(const SkimPage& page, const char* zip, std::vector<char>& raw) {
+
+    switch (static_cast<Codec>(page.codec)) {
+
+      case Codec::None:
+        if (page.zipBytes != page.rawBytes) return false;
+        raw.assign(zip, zip + page.rawBytes);
+        return true;
+
+#ifdef EPNEC_USE_ZSTD
+      case Codec::Zstd:
+      case Codec::ZstdDict:
+        {
+          if (ZSTD_getFrameContentSize(zip, page.zipBytes) != page.rawBytes) return false;
+          raw.resize(page.rawBytes);
+
+          ZSTD_DCtx*        dctx = static_cast<ZSTD_DCtx*>(m_dctx);
+          const std::size_t got  = (static_cast<Codec>(page.codec) == Codec::Zstd)
+            ? ZSTD_decompressDCtx(dctx, raw.data(), raw.size(), zip, page.zipBytes)
+            : ZSTD_decompress_usingDDict(dctx, raw.data(), raw.size(), zip, page.zipBytes, static_cast<ZSTD_DDict*>(m_ddicts[page.column]));
+          return !ZSTD_isError(got) && (got == page.rawBytes);
+        }
+#endif
+
+#ifdef EPNEC_USE_LZ4
+      case Codec::LZ4:
+        // n.b. LZ4 expands by at most ~255x
+        if ((page.rawBytes > 255 * page.zipBytes + 16) || (page.rawBytes > static_cast<uint64_t>(LZ4_MAX_INPUT_SIZE))) return false;
+        raw.resize(page.rawBytes);
+        return LZ4_decompress_safe(zip, raw.data(), page.zipBytes, raw.size()) == static_cast<int>(page.rawBytes);
+#endif
+
+      default:
+        std::cerr << "PANIC: skim page uses a codec this build doesn't support!" << std::endl;
+        return false;
+    }
+
+  }  // end 'Decompress(SkimPage&, char*, std::vector<char>&)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,229 @@
+// ============================================================================
+//! \file   Skim.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Columnar skim format written by the Extractor
+//! and read by the Calculator.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_Skim_hxx
+#define EPNucleonEnergyCorrelator_Skim_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+// package components
+#include "EventBatch.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Page compression codecs
+  // ==========================================================================
+  enum class Codec : uint8_t {
+    None     = 0,  //!< stored as is
+    Zstd     = 1,  //!< plain zstd
+    ZstdDict = 2,  //!< zstd with a per-column trained dictionary
+    LZ4      = 3   //!< lz4
+  };
+
+
+
+  // ==========================================================================
+  //! Skim writer options
+  // ==========================================================================
+  struct SkimOptions {
+    Codec       codec         = Codec::Zstd;  //!< page codec
+    int         level         = 3;            //!< compression level (zstd only)
+    std::size_t eventsPerPage = 256;          //!< no. of events per page
+    std::size_t trainBatches  = 4;            //!< no. of batches to sample for dictionary training
+    std::size_t dictSize      = 16384;        //!< max dictionary size in bytes
+  };
+
+
+
+  // ==========================================================================
+  //! How skim readers get bytes off storage
+  // ==========================================================================
+  enum class ReadBackend {
+    Pread,  //!< one blocking pread per page
+    Uring   //!< all pages of a cluster queued at once on io_uring (linux only)
+  };
+
+
+
+  // ==========================================================================
+  //! Skim reader options
+  // ==========================================================================
+  struct SkimReaderOptions {
+    ReadBackend backend    = ReadBackend::Pread;  //!< i/o backend
+    unsigned    queueDepth = 256;                 //!< max no. of reads in flight (io_uring only)
+    std::size_t arenaBytes = 32 << 20;            //!< size of registered read buffer (io_uring only)
+  };
+
+
+
+  // ==========================================================================
+  //! Location of a page in a skim
+  // ==========================================================================
+  struct SkimPage {
+    uint32_t column   = 0;  //!< column index
+    uint32_t cluster  = 0;  //!< cluster (written batch) index
+    uint8_t  codec    = 0;  //!< codec used for this page
+    uint64_t offset   = 0;  //!< offset in file
+    uint64_t zipBytes = 0;  //!< stored size
+    uint64_t rawBytes = 0;  //!< decompressed size
+  };
+
+
+
+  // ==========================================================================
+  //! Skim column table
+  // --------------------------------------------------------------------------
+  //! Every column of an EventBatch is stored; per-
+  //! event particle counts replace the offsets.
+  //! Skims from before the lab-frame columns only
+  //! have the first NBreitColumns, and are read
+  //! with empty lab-frame particles.
+  // ==========================================================================
+  namespace SkimColumns {
+    constexpr std::size_t NBreitColumns = 18;
+    constexpr std::size_t NColumns      = 30;
+    extern const char* const Names[NColumns];
+
+    // get the bytes of rows [first, last) of a column
+    void Get(const EventBatch& batch, const std::size_t iCol, const std::size_t first, const std::size_t last, std::vector<char>& out);
+
+    // append bytes to a column
+    bool Append(EventBatch& batch, const std::size_t iCol, const char* data, const std::size_t size);
+
+    // rows of a column in events [first, last)
+    void Rows(const EventBatch& batch, const std::size_t iCol, const std::size_t first, const std::size_t last, std::size_t& rowFirst, std::size_t& rowLast);
+  }
+
+
+
+  // ==========================================================================
+  //! Skim writer
+  // --------------------------------------------------------------------------
+  //! Each batch is written as a cluster of pages,
+  //! one page per column per eventsPerPage events.
+  //! With Codec::ZstdDict the first trainBatches
+  //! batches are held back, a dictionary is trained
+  //! per column on their pages and stored in the
+  //! footer; small per-event pages compress much
+  //! better that way.
+  // ==========================================================================
+  class SkimWriter {
+
+    public:
+
+      // ctor/dtor
+      SkimWriter(const SkimOptions& opt = SkimOptions()) : m_opt(opt) {};
+      ~SkimWriter();
+
+      // interface
+      bool Open(const std::string& path);
+      bool Write(const EventBatch& batch);
+      bool Close();
+
+      // getters
+      uint64_t GetRawBytes() const {return m_rawBytes;}
+      uint64_t GetZipBytes() const {return m_zipBytes;}
+
+    private:
+
+      // a page waiting to be compressed
+      struct RawPage {
+        uint32_t          column;
+        uint32_t          cluster;
+        std::vector<char> data;
+      };
+
+      // helper methods
+      void Paginate(const EventBatch& batch, std::vector<RawPage>& pages);
+      bool Flush(const RawPage& page);
+      bool Train();
+
+      // members
+      SkimOptions                    m_opt;
+      std::FILE*                     m_file     = nullptr;
+      uint64_t                       m_offset   = 0;
+      uint32_t                       m_nCluster = 0;
+      uint64_t                       m_rawBytes = 0;
+      uint64_t                       m_zipBytes = 0;
+      bool                           m_trained  = false;
+      std::vector<RawPage>           m_held;
+      std::vector<std::vector<char>> m_dicts;
+      std::vector<void*>             m_cdicts;
+      void*                          m_cctx     = nullptr;
+      std::vector<SkimPage>          m_pages;
+      std::vector<char>              m_zip;
+
+  };  // end SkimWriter
+
+
+
+  // ==========================================================================
+  //! Skim reader
+  // --------------------------------------------------------------------------
+  //! Reads a skim one cluster at a time. With the
+  //! io_uring backend, the pages of a cluster are
+  //! queued as one batch of fixed-buffer reads into
+  //! a registered arena, so local NVMe sees a deep
+  //! queue instead of one read at a time. Falls back
+  //! to pread where io_uring isn't available.
+  // ==========================================================================
+  class SkimReader {
+
+    public:
+
+      // ctor/dtor
+      SkimReader(const SkimReaderOptions& opt = SkimReaderOptions()) : m_opt(opt) {};
+      ~SkimReader();
+
+      // interface
+      bool Open(const std::string& path);
+      bool Read(const std::size_t iCluster, EventBatch& batch);
+      void Close();
+
+      // getters
+      std::size_t                  NClusters() const {return m_nClusters;}
+      const std::vector<SkimPage>& GetPages() const {return m_pages;}
+      uint64_t                     GetBytesRead() const {return m_bytesRead;}
+
+    private:
+
+      // helper methods
+      bool ReadAt(const uint64_t offset, const uint64_t size, char* buffer);
+      bool ReadQueued(const std::size_t first, const std::size_t last, EventBatch& batch);
+      bool Decompress(const SkimPage& page, const char* zip, std::vector<char>& raw);
+
+      // members
+      SkimReaderOptions              m_opt;
+      int                            m_fd        = -1;
+      std::size_t                    m_nClusters = 0;
+      uint64_t                       m_bytesRead = 0;
+      std::vector<SkimPage>          m_pages;
+      std::vector<std::size_t>       m_clusterStart;
+      std::vector<std::vector<char>> m_dicts;
+      std::vector<void*>             m_ddicts;
+      void*                          m_dctx      = nullptr;
+      std::vector<char>              m_zip;
+      std::vector<char>              m_raw;
+      void*                          m_ring      = nullptr;
+      std::vector<char>              m_arena;
+      std::vector<uint64_t>          m_slots;
+
+  };  // end SkimReader
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,338 @@
+// ============================================================================
+//! \file   SortedSkim.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Sorting skims on the (run, event) key and
+//! joining sorted skims.
+// ============================================================================
+
+#include "SortedSkim.hxx"
+
+// c++ utilities
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+
+
+namespace {
+
+  using namespace EPNucleonEnergyCorrelator;
+
+  // a run of sorted clusters [first, last)
+  using Run = std::pair<std::size_t, std::size_t>;
+
+  // merge runs [first, last) of a skim into the
+  // writer, counting the clusters written
+  bool mergeRuns(
+    SkimReader& reader,
+    const std::vector<Run>& runs,
+    const std::size_t first,
+    const std::size_t last,
+    SkimWriter& writer,
+    const std::size_t batchSize,
+    std::size_t& nWritten
+  ) {
+
+    // n.b. ties go to the earlier run, so the merge
+    // is stable
+    using Entry = std::pair<uint64_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+    std::vector<SkimCursor> cursors(last - first);
+    for (std::size_t iRun = 0; iRun < cursors.size(); ++iRun) {
+      if (cursors[iRun].Open(reader, runs[first + iRun].first, runs[first + iRun].second)) {
+        heap.push({cursors[iRun].Key(), iRun});
+      }
+    }
+
+    EventBatch batch;
+    while (!heap.empty()) {
+      const std::size_t iRun = heap.top().second;
+      heap.pop();
+
+      batch.AddEvent(cursors[iRun].Batch(), cursors[iRun].Event());
+      if (batch.NEvents() >= batchSize) {
+        if (!writer.Write(batch)) return false;
+        ++nWritten;
+        batch.Clear();
+      }
+      if (cursors[iRun].Next()) {
+        heap.push({cursors[iRun].Key(), iRun});
+      }
+    }
+    if (batch.NEvents() > 0) {
+      if (!writer.Write(batch)) return false;
+      ++nWritten;
+    }
+
+    for (const auto& cursor : cursors) {
+      if (!cursor.Readable()) {
+        std::cerr << "PANIC: couldn't read skim cluster, can't merge!" << std::endl;
+        return false;
+      }
+      if (!cursor.Sorted()) {
+        std::cerr << "PANIC: skim cluster isn't sorted, can't merge!" << std::endl;
+        return false;
+      }
+    }
+    return true;
+
+  }  // end 'mergeRuns(...)'
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Sort the events of a batch on their key
+  // --------------------------------------------------------------------------
+  void SortBatch(EventBatch& batch) {
+
+    if (std::is_sorted(batch.key.begin(), batch.key.end())) return;
+
+    std::vector<std::size_t> order(batch.NEvents());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+      order.begin(),
+      order.end(),
+      [&batch](const std::size_t a, const std::size_t b) {return batch.key[a] < batch.key[b];}
+    );
+
+    EventBatch sorted;
+    for (const std::size_t iEvent : order) {
+      sorted.AddEvent(batch, iEvent);
+    }
+    batch = std::move(sorted);
+
+  }  // end 'SortBatch(EventBatch&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Sort a skim whose clusters are each sorted
+  // --------------------------------------------------------------------------
+  //! Intermediate passes are written next to the
+  //! output and removed when done, or when a pass
+  //! fails, along with a partial output; they use
+  //! plain zstd rather than retraining dictionaries
+  //! every pass.
+  bool SortSkim(
+    const std::string& in,
+    const std::string& out,
+    const SkimOptions& opt,
+    const std::size_t batchSize,
+    const std::size_t fanIn
+  ) {
+
+    const std::size_t fan  = std::max<std::size_t>(2, fanIn);
+    SkimOptions       pass = opt;
+    if (pass.codec == Codec::ZstdDict) {
+      pass.codec = Codec::Zstd;
+    }
+
+    // every cluster starts as a run of its own
+    std::vector<Run> runs;
+    {
+      SkimReader reader;
+      if (!reader.Open(in)) return false;
+      for (std::size_t iCluster = 0; iCluster < reader.NClusters(); ++iCluster) {
+        runs.push_back({iCluster, iCluster + 1});
+      }
+    }
+
+    std::string source = in;
+    std::size_t iPass  = 0;
+    do {
+      const bool        final  = (runs.size() <= fan);
+      const std::string target = final ? out : out + ".pass" + std::to_string(iPass);
+
+      SkimReader reader;
+      SkimWriter writer(final ? opt : pass);
+      auto fail = [&]() {
+        writer.Close();
+        reader.Close();
+        std::remove(target.data());
+        if (source != in) {
+          std::remove(source.data());
+        }
+        return false;
+      };
+      if (!reader.Open(source) || !writer.Open(target)) return fail();
+
+      std::vector<Run> merged;
+      std::size_t      nWritten = 0;
+      for (std::size_t first = 0; first < runs.size(); first += fan) {
+        const std::size_t start = nWritten;
+        if (!mergeRuns(reader, runs, first, std::min(first + fan, runs.size()), writer, batchSize, nWritten)) {
+          return fail();
+        }
+        merged.push_back({start, nWritten});
+      }
+      if (!writer.Close()) return fail();
+      reader.Close();
+
+      if (source != in) {
+        std::remove(source.data());
+      }
+      std::cout << "    Sort pass " << iPass << ": merged " << runs.size() << " runs into " << merged.size() << std::endl;
+
+      source = target;
+      runs   = merged;
+      ++iPass;
+    } while (source != out);
+    return true;
+
+  }  // end 'SortSkim(std::string& x 2, SkimOptions&, std::size_t x 2)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Start at the first event of clusters [first, last)
+  // --------------------------------------------------------------------------
+  //! Returns false if there are no events, or the
+  //! first cluster can't be read.
+  bool SkimCursor::Open(SkimReader& reader, const std::size_t first, const std::size_t last) {
+
+    m_reader   = &reader;
+    m_cluster  = first;
+    m_last     = last;
+    m_started  = false;
+    m_sorted   = true;
+    m_readable = true;
+    return Load();
+
+  }  // end 'Open(SkimReader&, std::size_t, std::size_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Move to the next event
+  // --------------------------------------------------------------------------
+  //! Returns false at the end, or if the key went
+  //! down, in which case Sorted() is false, or if a
+  //! cluster can't be read, in which case Readable()
+  //! is false.
+  bool SkimCursor::Next() {
+
+    if (!m_valid) return false;
+
+    if (++m_event >= m_batch.NEvents()) {
+      ++m_cluster;
+      return Load();
+    }
+    if (Key() < m_prev) {
+      m_sorted = false;
+      m_valid  = false;
+      return false;
+    }
+    m_prev = Key();
+    return true;
+
+  }  // end 'Next()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Load the next non-empty cluster
+  // --------------------------------------------------------------------------
+  bool SkimCursor::Load() {
+
+    m_valid = false;
+    m_event = 0;
+    for (; m_cluster < m_last; ++m_cluster) {
+      if (!m_reader->Read(m_cluster, m_batch)) {
+        m_readable = false;
+        return false;
+      }
+      if (m_batch.NEvents() > 0) break;
+    }
+    if (m_cluster >= m_last) return false;
+
+    if (m_started && (Key() < m_prev)) {
+      m_sorted = false;
+      return false;
+    }
+    m_prev    = Key();
+    m_started = true;
+    m_valid   = true;
+    return true;
+
+  }  // end 'Load()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Open both skims
+  // --------------------------------------------------------------------------
+  bool SkimJoiner::Open(const std::string& recPath, const std::string& genPath) {
+
+    if (!m_recReader.Open(recPath) || !m_genReader.Open(genPath)) {
+      return false;
+    }
+    m_rec.Open(m_recReader, 0, m_recReader.NClusters());
+    m_gen.Open(m_genReader, 0, m_genReader.NClusters());
+    return true;
+
+  }  // end 'Open(std::string&, std::string&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Fill a batch with the next joined events
+  // --------------------------------------------------------------------------
+  //! Events present in only one skim are counted and
+  //! skipped. Returns false once both skims are
+  //! exhausted, or if either turns out not to be
+  //! sorted or readable; Failed() tells them apart.
+  bool SkimJoiner::Next(EventBatch& batch, const std::size_t batchSize) {
+
+    batch.Clear();
+    while ((batch.NEvents() < batchSize) && m_rec.Valid() && m_gen.Valid()) {
+      const uint64_t recKey = m_rec.Key();
+      const uint64_t genKey = m_gen.Key();
+      if (recKey < genKey) {
+        ++m_nRecOnly;
+        m_rec.Next();
+      } else if (genKey < recKey) {
+        ++m_nGenOnly;
+        m_gen.Next();
+      } else {
+        batch.AddEvent(m_rec.Batch(), m_rec.Event(), m_gen.Batch(), m_gen.Event());
+        ++m_nJoined;
+        m_rec.Next();
+        m_gen.Next();
+      }
+    }
+
+    // whatever is left of one skim has no partner
+    if (!m_rec.Valid() || !m_gen.Valid()) {
+      for (; m_rec.Valid(); m_rec.Next()) ++m_nRecOnly;
+      for (; m_gen.Valid(); m_gen.Next()) ++m_nGenOnly;
+    }
+
+    if (!m_rec.Readable() || !m_gen.Readable()) {
+      std::cerr << "PANIC: couldn't read a cluster of the joined skims!" << std::endl;
+      batch.Clear();
+      return false;
+    }
+    if (!m_rec.Sorted() || !m_gen.Sorted()) {
+      std::cerr << "PANIC: joined skims must be sorted on the event key!" << std::endl;
+      batch.Clear();
+      return false;
+    }
+    return batch.NEvents() > 0;
+
+  }  // end 'Next(EventBatch&, std::size_t)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,144 @@
+// ============================================================================
+//! \file   SortedSkim.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Sorting skims on the (run, event) key and
+//! joining sorted skims.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_SortedSkim_hxx
+#define EPNucleonEnergyCorrelator_SortedSkim_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <string>
+// package components
+#include "EventBatch.hxx"
+#include "Skim.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Sort the events of a batch on their key
+  // --------------------------------------------------------------------------
+  void SortBatch(EventBatch& batch);
+
+
+
+  // --------------------------------------------------------------------------
+  //! Sort a skim whose clusters are each sorted
+  // --------------------------------------------------------------------------
+  //! External k-way merge: each pass merges groups
+  //! of fanIn runs (starting from single clusters)
+  //! into longer runs, so memory stays at about
+  //! fanIn + 1 batches however large the skim is.
+  bool SortSkim(
+    const std::string& in,
+    const std::string& out,
+    const SkimOptions& opt,
+    const std::size_t batchSize,
+    const std::size_t fanIn = 16
+  );
+
+
+
+  // ==========================================================================
+  //! Event-by-event cursor over clusters of a skim
+  // --------------------------------------------------------------------------
+  //! Holds one cluster in memory at a time, and
+  //! flags if keys ever go down or a cluster can't
+  //! be read.
+  // ==========================================================================
+  class SkimCursor {
+
+    public:
+
+      // ctor/dtor
+      SkimCursor()  {};
+      ~SkimCursor() {};
+
+      // interface
+      bool Open(SkimReader& reader, const std::size_t first, const std::size_t last);
+      bool Next();
+
+      // getters
+      bool              Valid() const {return m_valid;}
+      bool              Sorted() const {return m_sorted;}
+      bool              Readable() const {return m_readable;}
+      uint64_t          Key() const {return m_batch.key[m_event];}
+      const EventBatch& Batch() const {return m_batch;}
+      std::size_t       Event() const {return m_event;}
+
+    private:
+
+      // helper methods
+      bool Load();
+
+      // members
+      SkimReader* m_reader   = nullptr;
+      std::size_t m_cluster  = 0;
+      std::size_t m_last     = 0;
+      std::size_t m_event    = 0;
+      uint64_t    m_prev     = 0;
+      bool        m_started  = false;
+      bool        m_valid    = false;
+      bool        m_sorted   = true;
+      bool        m_readable = true;
+      EventBatch  m_batch;
+
+  };  // end SkimCursor
+
+
+
+  // ==========================================================================
+  //! Sorted merge-join of a reconstructed and a generated skim
+  // --------------------------------------------------------------------------
+  //! Streams both skims in key order and pairs the
+  //! reconstructed side of each event in one with
+  //! the generated side of the same event in the
+  //! other, holding a single cluster of each in
+  //! memory. Both skims must be sorted (as written
+  //! by the Extractor). The reconstructed skim's
+  //! matching indices point into its own generated
+  //! particles, so rec particles of joined events
+  //! are left unmatched (-1).
+  // ==========================================================================
+  class SkimJoiner {
+
+    public:
+
+      // ctor/dtor
+      SkimJoiner()  {};
+      ~SkimJoiner() {};
+
+      // interface
+      bool Open(const std::string& recPath, const std::string& genPath);
+      bool Next(EventBatch& batch, const std::size_t batchSize);
+
+      // getters
+      uint64_t NJoined() const {return m_nJoined;}
+      uint64_t NRecOnly() const {return m_nRecOnly;}
+      uint64_t NGenOnly() const {return m_nGenOnly;}
+      bool     Failed() const {return !m_rec.Readable() || !m_gen.Readable() || !m_rec.Sorted() || !m_gen.Sorted();}
+
+    private:
+
+      // members
+      SkimReader m_recReader;
+      SkimReader m_genReader;
+      SkimCursor m_rec;
+      SkimCursor m_gen;
+      uint64_t   m_nJoined  = 0;
+      uint64_t   m_nRecOnly = 0;
+      uint64_t   m_nGenOnly = 0;
+
+  };  // end SkimJoiner
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
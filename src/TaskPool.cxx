@@ -0,0 +1,271 @@
+// ============================================================================
+//! \file   TaskPool.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Work-stealing thread pool used to schedule
+//! work units.
+// ============================================================================
+
+#include "TaskPool.hxx"
+
+// c++ utilities
+#include <algorithm>
+
+
+
+namespace {
+
+  // worker index of current thread
+  thread_local int CurrentWorker = -1;
+
+  // pool the current thread works for
+  thread_local const void* CurrentPool = nullptr;
+
+}  // end anonymous namespace
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Default ctor
+  // --------------------------------------------------------------------------
+  TaskPool::TaskPool(const unsigned nThreads) : m_pending(0), m_next(0), m_stop(false) {
+
+    const unsigned nWorkers = std::max(1u, nThreads);
+    for (unsigned iWorker = 0; iWorker < nWorkers; ++iWorker) {
+      m_queues.emplace_back(new Queue());
+    }
+    for (unsigned iWorker = 0; iWorker < nWorkers; ++iWorker) {
+      m_threads.emplace_back(&TaskPool::Work, this, iWorker);
+    }
+
+  }  // end ctor(unsigned)
+
+
+
+  // --------------------------------------------------------------------------
+  //! Default dtor
+  // --------------------------------------------------------------------------
+  TaskPool::~TaskPool() {
+
+    Wait();
+    {
+      std::lock_guard<std::mutex> guard(m_sleepLock);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+      thread.join();
+    }
+
+  }  // end dtor
+
+
+
+  // --------------------------------------------------------------------------
+  //! Queue a task
+  // --------------------------------------------------------------------------
+  //! Tasks submitted from a worker go to its own
+  //! queue, others are dealt out round-robin.
+  void TaskPool::Submit(Task task) {
+
+    const unsigned iQueue = (CurrentPool == this)
+      ? static_cast<unsigned>(CurrentWorker)
+      : (m_next++ % m_queues.size());
+
+    ++m_pending;
+    {
+      std::lock_guard<std::mutex> guard(m_queues[iQueue]->lock);
+      m_queues[iQueue]->tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_sleepLock);
+    }
+    m_wake.notify_one();
+
+  }  // end 'Submit(Task)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Block until all queued tasks are done
+  // --------------------------------------------------------------------------
+  //! A worker calling this keeps running tasks
+  //! instead of blocking, so it can't deadlock the
+  //! pool.
+  void TaskPool::Wait() {
+
+    if (CurrentPool == this) {
+      while (m_pending > 0) {
+        if (!RunOne()) std::this_thread::yield();
+      }
+      return;
+    }
+
+    std::unique_lock<std::mutex> guard(m_sleepLock);
+    m_done.wait(guard, [this]() {return m_pending == 0;});
+
+  }  // end 'Wait()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Run one queued task on the calling worker
+  // --------------------------------------------------------------------------
+  //! Returns false if there was nothing to run.
+  bool TaskPool::RunOne() {
+
+    if (CurrentPool != this) return false;
+
+    Task task;
+    if (!Pop(CurrentWorker, task)) return false;
+
+    task();
+    if (--m_pending == 0) {
+      std::lock_guard<std::mutex> guard(m_sleepLock);
+      m_done.notify_all();
+    }
+    return true;
+
+  }  // end 'RunOne()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get index of calling worker
+  // --------------------------------------------------------------------------
+  int TaskPool::WorkerIndex() {
+
+    return CurrentWorker;
+
+  }  // end 'WorkerIndex()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Get pool of calling worker
+  // --------------------------------------------------------------------------
+  const TaskPool* TaskPool::Current() {
+
+    return static_cast<const TaskPool*>(CurrentPool);
+
+  }  // end 'Current()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Worker loop
+  // --------------------------------------------------------------------------
+  void TaskPool::Work(const unsigned iWorker) {
+
+    CurrentWorker = iWorker;
+    CurrentPool   = this;
+    while (true) {
+      if (RunOne()) continue;
+
+      std::unique_lock<std::mutex> guard(m_sleepLock);
+      if (m_stop) break;
+
+      // n.b. re-check under the lock so a submit
+      // between RunOne() and here isn't missed
+      bool empty = true;
+      for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> queueGuard(queue->lock);
+        empty = empty && queue->tasks.empty();
+      }
+      if (empty) m_wake.wait(guard);
+    }
+
+  }  // end 'Work(unsigned)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Take a task from own queue or steal one
+  // --------------------------------------------------------------------------
+  bool TaskPool::Pop(const unsigned iWorker, Task& task) {
+
+    // own queue: newest first
+    {
+      Queue& own = *m_queues[iWorker];
+      std::lock_guard<std::mutex> guard(own.lock);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+
+    // others: oldest first
+    for (std::size_t iOffset = 1; iOffset < m_queues.size(); ++iOffset) {
+      Queue& other = *m_queues[(iWorker + iOffset) % m_queues.size()];
+      std::lock_guard<std::mutex> guard(other.lock);
+      if (!other.tasks.empty()) {
+        task = std::move(other.tasks.front());
+        other.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+
+  }  // end 'Pop(unsigned, Task&)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Queue a task in the group
+  // --------------------------------------------------------------------------
+  void TaskGroup::Run(TaskPool::Task task) {
+
+    ++m_state->count;
+    {
+      std::lock_guard<std::mutex> guard(m_state->lock);
+      m_state->tasks.push_back(std::move(task));
+    }
+    m_pool.Submit([state = m_state]() {
+      state->RunOne();
+    });
+
+  }  // end 'Run(TaskPool::Task)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Wait for all tasks of the group
+  // --------------------------------------------------------------------------
+  //! Runs the group's tasks which no worker has
+  //! taken yet, then waits for the rest.
+  void TaskGroup::Wait() {
+
+    while (m_state->count > 0) {
+      if (!m_state->RunOne()) std::this_thread::yield();
+    }
+
+  }  // end 'Wait()'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Run the next task the group holds
+  // --------------------------------------------------------------------------
+  //! Returns false if there was nothing to run.
+  bool TaskGroup::State::RunOne() {
+
+    TaskPool::Task task;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (tasks.empty()) return false;
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    task();
+    --count;
+    return true;
+
+  }  // end 'State::RunOne()'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
@@ -0,0 +1,131 @@
+// ============================================================================
+//! \file   TaskPool.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Work-stealing thread pool used to schedule
+//! work units.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_TaskPool_hxx
+#define EPNucleonEnergyCorrelator_TaskPool_hxx
+
+// c++ utilities
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! Work-stealing task pool
+  // --------------------------------------------------------------------------
+  //! Each worker has its own deque: it pushes and
+  //! pops at the back (so nested tasks stay hot in
+  //! cache) and steals from the front of the others
+  //! when it runs dry. Tasks can query WorkerIndex()
+  //! to pick their thread-local state.
+  // ==========================================================================
+  class TaskPool {
+
+    public:
+
+      using Task = std::function<void()>;
+
+      // ctor/dtor
+      TaskPool(const unsigned nThreads = 1);
+      ~TaskPool();
+
+      // interface
+      void Submit(Task task);
+      void Wait();
+      bool RunOne();
+
+      // getters
+      unsigned NWorkers() const {return m_queues.size();}
+
+      // index of calling worker in [0, NWorkers()), or -1 outside a pool
+      static int WorkerIndex();
+
+      // pool the calling thread works for, or nullptr
+      static const TaskPool* Current();
+
+    private:
+
+      // a worker's queue
+      struct Queue {
+        std::mutex       lock;
+        std::deque<Task> tasks;
+      };
+
+      // helper methods
+      void Work(const unsigned iWorker);
+      bool Pop(const unsigned iWorker, Task& task);
+
+      // members
+      std::vector<std::unique_ptr<Queue>> m_queues;
+      std::vector<std::thread>            m_threads;
+      std::atomic<std::size_t>            m_pending;
+      std::atomic<unsigned>               m_next;
+      std::atomic<bool>                   m_stop;
+      std::mutex                          m_sleepLock;
+      std::condition_variable             m_wake;
+      std::condition_variable             m_done;
+
+  };  // end TaskPool
+
+
+
+  // ==========================================================================
+  //! Group of tasks which can be waited on together
+  // --------------------------------------------------------------------------
+  //! Used to fork nested tasks from inside a task.
+  //! Tasks are held by the group, and the pool only
+  //! gets a stand-in per task which runs the next
+  //! one the group still holds. Wait() runs the
+  //! group's own tasks meanwhile, but never anything
+  //! else queued on the pool, so the waiting task
+  //! can't be re-entered through its own worker.
+  // ==========================================================================
+  class TaskGroup {
+
+    public:
+
+      // ctor/dtor
+      TaskGroup(TaskPool& pool) : m_pool(pool), m_state(std::make_shared<State>()) {};
+      ~TaskGroup() {Wait();};
+
+      // interface
+      void Run(TaskPool::Task task);
+      void Wait();
+
+    private:
+
+      // tasks of the group, shared with the stand-ins
+      // so they can outlive it
+      struct State {
+        std::mutex                 lock;
+        std::deque<TaskPool::Task> tasks;
+        std::atomic<std::size_t>   count{0};
+
+        bool RunOne();
+      };
+
+      // members
+      TaskPool&              m_pool;
+      std::shared_ptr<State> m_state;
+
+  };  // end TaskGroup
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================
@@ -0,0 +1,82 @@
+// ============================================================================
+//! \file   WorkPlan.cxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Splits input files into cluster-aligned work
+//! units using the file catalog.
+// ============================================================================
+
+#include "WorkPlan.hxx"
+
+// c++ utilities
+#include <algorithm>
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // --------------------------------------------------------------------------
+  //! Plan work units
+  // --------------------------------------------------------------------------
+  std::vector<WorkUnit> PlanWork(
+    const std::vector<std::string>& files,
+    const FileCatalog& catalog,
+    const int64_t entriesPerUnit
+  ) {
+
+    std::vector<WorkUnit> units;
+    for (std::size_t iFile = 0; iFile < files.size(); ++iFile) {
+
+      const FileMetadata* meta = catalog.Find(files[iFile]);
+      if (!meta || (meta->clusters.size() < 2)) {
+        units.push_back({iFile, files[iFile], 0, -1});
+        continue;
+      }
+
+      // n.b. clusters holds the first entry of each
+      // cluster followed by the no. of entries
+      int64_t first = meta->clusters.front();
+      for (std::size_t iCluster = 1; iCluster < meta->clusters.size(); ++iCluster) {
+        const int64_t boundary = meta->clusters[iCluster];
+        const bool    isLast   = (iCluster + 1 == meta->clusters.size());
+        if (((boundary - first) >= entriesPerUnit) || isLast) {
+          if (boundary > first) {
+            units.push_back({iFile, files[iFile], first, boundary});
+          }
+          first = boundary;
+        }
+      }
+    }
+    return units;
+
+  }  // end 'PlanWork(std::vector<std::string>&, FileCatalog&, int64_t)'
+
+
+
+  // --------------------------------------------------------------------------
+  //! Plan work units over byte ranges
+  // --------------------------------------------------------------------------
+  std::vector<WorkUnit> PlanByteRanges(
+    const std::vector<std::string>& files,
+    const std::vector<int64_t>& sizes,
+    const int64_t bytesPerUnit
+  ) {
+
+    std::vector<WorkUnit> units;
+    for (std::size_t iFile = 0; iFile < files.size(); ++iFile) {
+      if ((sizes[iFile] < 0) || (bytesPerUnit <= 0)) {
+        units.push_back({iFile, files[iFile], 0, -1});
+        continue;
+      }
+      for (int64_t first = 0; first < sizes[iFile]; first += bytesPerUnit) {
+        units.push_back({iFile, files[iFile], first, std::min(first + bytesPerUnit, sizes[iFile])});
+      }
+    }
+    return units;
+
+  }  // end 'PlanByteRanges(std::vector<std::string>&, std::vector<int64_t>&, int64_t)'
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+// end ========================================================================
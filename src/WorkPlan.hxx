@@ -0,0 +1,74 @@
+// ============================================================================
+//! \file   WorkPlan.hxx
+//! \author Derek Anderson
+//! \date   10.18.2026
+// ----------------------------------------------------------------------------
+//! Splits input files into cluster-aligned work
+//! units using the file catalog.
+// ============================================================================
+
+#ifndef EPNucleonEnergyCorrelator_WorkPlan_hxx
+#define EPNucleonEnergyCorrelator_WorkPlan_hxx
+
+// c++ utilities
+#include <cstdint>
+#include <string>
+#include <vector>
+// package components
+#include "FileCatalog.hxx"
+
+
+
+namespace EPNucleonEnergyCorrelator {
+
+  // ==========================================================================
+  //! One unit of work: a range of entries in a file
+  // --------------------------------------------------------------------------
+  //! For text input (e.g. HepMC3 ASCII) the range
+  //! is in bytes instead of entries.
+  // ==========================================================================
+  struct WorkUnit {
+    std::size_t file  = 0;   //!< index of file in input list
+    std::string path;        //!< path to file
+    int64_t     first = 0;   //!< first entry (or byte)
+    int64_t     last  = -1;  //!< one past last entry (or byte, -1 = end of file)
+  };
+
+
+
+  // ==========================================================================
+  //! Plan work units
+  // --------------------------------------------------------------------------
+  //! Files in the catalog are cut at cluster
+  //! boundaries into units of at least
+  //! entriesPerUnit entries, so no two units ever
+  //! decompress the same basket. Files missing from
+  //! the catalog become a single unit.
+  // ==========================================================================
+  std::vector<WorkUnit> PlanWork(
+    const std::vector<std::string>& files,
+    const FileCatalog& catalog,
+    const int64_t entriesPerUnit
+  );
+
+
+
+  // ==========================================================================
+  //! Plan work units over byte ranges
+  // --------------------------------------------------------------------------
+  //! Cuts each file into ranges of bytesPerUnit
+  //! bytes; the reader is responsible for moving
+  //! each range to event boundaries. Files of
+  //! unknown size (< 0) become a single unit.
+  // ==========================================================================
+  std::vector<WorkUnit> PlanByteRanges(
+    const std::vector<std::string>& files,
+    const std::vector<int64_t>& sizes,
+    const int64_t bytesPerUnit
+  );
+
+}  // end EPNucleonEnergyCorrelator namespace
+
+#endif
+
+// end ========================================================================